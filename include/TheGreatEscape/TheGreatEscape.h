@@ -31,7 +31,10 @@ extern "C"
 #endif
   
   
+#include <stddef.h>
+
 #include "ZXSpectrum/Spectrum.h"
+#include "ZXSpectrum/Keyboard.h"
 
 
 /* Exports go here... */
@@ -41,6 +44,22 @@ extern "C"
 typedef struct tgeconfig
 {
   int width, height;
+
+  /** Non-zero to skip transition animations, e.g. when running headless.
+   * The zoombox then opens at once without presenting each step. */
+  int skip_transitions;
+
+  /** Non-zero to skip the menu screen and start directly in play using
+   * input_device and, for the keyboard, keys. */
+  int skip_menu;
+
+  /** Input device used when skip_menu is set: 0 = Keyboard, 1 = Kempston,
+   * 2 = Sinclair, 3 = Protek. These match the menu's items. */
+  int input_device;
+
+  /** Keys used when skip_menu is set and input_device is the keyboard.
+   * In the order left, right, up, down, fire. */
+  zxkey_t keys[5];
 }
 tgeconfig_t;
 
@@ -49,12 +68,108 @@ tgeconfig_t;
  */
 typedef struct tgestate tgestate_t;
 
+/** Number of visible characters reported by tge_observe(). */
+#define TGE_OBSERVE_VISCHARS 8
+
+/** Number of items reported by tge_observe(). */
+#define TGE_OBSERVE_ITEMS    16
+
+/** Value used for an absent item, room or character. */
+#define TGE_OBSERVE_NONE     255
+
+/**
+ * An observed visible character.
+ */
+typedef struct tgeobservation_vischar
+{
+  uint16_t x, y, height; /**< Map position */
+  uint8_t  character;    /**< Character index, or TGE_OBSERVE_NONE if the
+                              slot is empty */
+  uint8_t  room;         /**< Room index: 0 is outdoors */
+  uint8_t  direction;    /**< Direction and walk/crawl flag */
+  uint8_t  flags;        /**< Behaviour flags */
+  uint8_t  input;        /**< Input moving the character. For the hero,
+                              the player's input as last read: 0 if none */
+}
+tgeobservation_vischar_t;
+
+/**
+ * An observed item.
+ */
+typedef struct tgeobservation_item
+{
+  uint8_t  x, y, height; /**< Position, at a smaller scale than vischars */
+  uint8_t  room;         /**< Room index: 0 is outdoors. TGE_OBSERVE_NONE if
+                              the item is nowhere */
+  uint8_t  held;         /**< Non-zero if the hero holds the item */
+  uint8_t  flags;        /**< Item flags: poisoned, picked up, etc. */
+}
+tgeobservation_item_t;
+
+/**
+ * A snapshot of the game state for automated players.
+ *
+ * The layout is fixed, and no pointers are involved, so observations may be
+ * copied or stored as they are.
+ */
+typedef struct tgeobservation
+{
+  /** Visible characters. vischars[0] is the hero. */
+  tgeobservation_vischar_t vischars[TGE_OBSERVE_VISCHARS];
+
+  /** Items, indexed by item number. */
+  tgeobservation_item_t    items[TGE_OBSERVE_ITEMS];
+
+  /** Searchlight positions. Only meaningful at night, outdoors. */
+  uint8_t  searchlights[3][2];
+
+  uint8_t  room;              /**< Hero's room index: 0 is outdoors */
+  uint8_t  items_held[2];     /**< Held items, or TGE_OBSERVE_NONE */
+  uint8_t  morale;            /**< 0 (none) to 112 (full) */
+  uint8_t  clock;             /**< Game clock, one tick per 64 frames */
+  uint8_t  day_or_night;      /**< 0 for day, 255 for night */
+  uint8_t  bell;              /**< 0 ringing, 255 stopped, else rings left */
+  uint8_t  searchlight_state; /**< 255 searching, 31 caught, else counter */
+  uint8_t  game_counter;      /**< Frame counter, wraps */
+  uint8_t  hero_in_bed;       /**< Non-zero if the hero is in bed */
+  uint8_t  hero_in_breakfast; /**< Non-zero if the hero is at breakfast */
+  uint8_t  red_flag;          /**< Non-zero if the hero is out of bounds */
+}
+tgeobservation_t;
+
+/**
+ * Alignment required of blocks passed to tge_create_in(), in bytes. A cache
+ * line.
+ */
+#define TGE_ALIGNMENT 64
+
 /**
  * Create a game instance.
+ *
+ * The instance occupies a single block of tge_footprint() bytes. In builds
+ * with TGE_NO_HEAP defined that block is static, so only one instance
+ * created this way may exist at a time.
  */
 TGE_API tgestate_t *tge_create(zxspectrum_t      *speccy,
                                const tgeconfig_t *config);
 
+/**
+ * Return the number of bytes a game instance occupies.
+ */
+TGE_API size_t tge_footprint(const tgeconfig_t *config);
+
+/**
+ * Create a game instance in caller-supplied memory.
+ *
+ * The state and all of its buffers are laid out within block, which must be
+ * aligned to TGE_ALIGNMENT and at least tge_footprint() bytes long. The
+ * caller still owns block once the instance is destroyed.
+ */
+TGE_API tgestate_t *tge_create_in(zxspectrum_t      *speccy,
+                                  const tgeconfig_t *config,
+                                  void              *block,
+                                  size_t             size);
+
 /**
  * Destroy a game instance.
  */
@@ -62,13 +177,88 @@ TGE_API void tge_destroy(tgestate_t *state);
 
 /**
  * Prepare the game for running.
+ *
+ * This runs the menu screen unless the instance was created with skip_menu
+ * set.
  */
 TGE_API void tge_setup(tgestate_t *state);
 
+/**
+ * Return a game instance to the state it had once tge_setup completed.
+ *
+ * The first instance in the process to complete tge_setup leaves an
+ * immutable template behind and this restores from that in a single copy.
+ * The instance's render interval, transition and menu settings, input
+ * device and keys are kept. Without a template for the instance's screen
+ * layout, this creates the instance afresh and calls tge_setup. Other
+ * instances in the process are unaffected.
+ */
+TGE_API void tge_reset(tgestate_t *state);
+
 /**
  * Invoke the game instance.
  */
 TGE_API void tge_main(tgestate_t *state);
+
+/**
+ * Set how often the game window is rendered.
+ *
+ * Frames which don't render still run all of the game logic, so the game
+ * plays out exactly as when every frame is rendered. They skip the tile,
+ * sprite and game window plotting. The first rendered frame after skipped
+ * ones repaints the game window in full.
+ *
+ * \param interval Render every interval'th frame. 1 (the default) renders
+ * every frame. 0 renders only frames requested with tge_request_render().
+ */
+TGE_API void tge_set_render_interval(tgestate_t *state, int interval);
+
+/**
+ * Render the next frame regardless of the render interval.
+ */
+TGE_API void tge_request_render(tgestate_t *state);
+
+/**
+ * Fill in an observation of the game's state, without rendering anything.
+ */
+TGE_API void tge_observe(const tgestate_t *state, tgeobservation_t *obs);
+
+/**
+ * Compare the games two instances are playing, ignoring how they render.
+ *
+ * The render interval, what rendering alone uses and where each instance
+ * lives in memory are left out. Two instances which have run the same frames
+ * with the same input compare equal whatever their render intervals.
+ *
+ * \return Zero if the games match.
+ */
+TGE_API int tge_compare(const tgestate_t *a, const tgestate_t *b);
+
+/**
+ * Write an asset pack holding the game's graphics and level data.
+ *
+ * This is done offline. The pack is specific to this build of the game.
+ *
+ * \return Non-zero if written, zero on error.
+ */
+TGE_API int tge_write_assets(const char *path);
+
+/**
+ * Use the graphics and level data in an asset pack.
+ *
+ * The pack is mapped into memory read-only, so processes using the same pack
+ * share its pages. It applies to all instances in the process and must be
+ * loaded or unloaded only while none are running. The compiled-in data stays
+ * in use if the pack can't be mapped or doesn't match this build.
+ *
+ * \return Non-zero if the pack is in use, zero otherwise.
+ */
+TGE_API int tge_load_assets(const char *path);
+
+/**
+ * Stop using any asset pack and return to the compiled-in data.
+ */
+TGE_API void tge_unload_assets(void);
   
 
 #ifdef __cplusplus
@@ -0,0 +1,116 @@
+/* ZXAudio.h
+ *
+ * ZX Spectrum beeper synthesis.
+ *
+ * Copyright (c) David Thomas, 2013-2016. <dave@davespace.co.uk>
+ */
+
+#ifndef ZXSPECTRUM_AUDIO_H
+#define ZXSPECTRUM_AUDIO_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Rate of the virtual Z80 clock, in T-states per second. */
+#define ZXAUDIO_CLOCK_RATE  3500000
+
+/** Rate of the synthesised output, in 16-bit mono samples per second. */
+#define ZXAUDIO_SAMPLE_RATE 44100
+
+/** Length of a WAV file header, in bytes. */
+#define ZXAUDIO_WAV_HEADER_LENGTH 44
+
+/**
+ * A beeper synthesiser.
+ */
+typedef struct zxaudio zxaudio_t;
+
+/**
+ * Create a beeper synthesiser.
+ *
+ * \return New synthesiser, or NULL if out of memory.
+ */
+zxaudio_t *zxaudio_create(void);
+
+/**
+ * Destroy a beeper synthesiser.
+ *
+ * \param[in] doomed Doomed synthesiser.
+ */
+void zxaudio_destroy(zxaudio_t *doomed);
+
+/**
+ * Return the number of bytes a beeper synthesiser occupies.
+ *
+ * \return Size of a synthesiser, in bytes.
+ */
+size_t zxaudio_footprint(void);
+
+/**
+ * Initialise a beeper synthesiser in caller-supplied memory. It needs no
+ * finalisation.
+ *
+ * \param[in] block Memory of at least zxaudio_footprint() bytes, aligned to
+ *                  at least eight bytes.
+ *
+ * \return Synthesiser (at block).
+ */
+zxaudio_t *zxaudio_init(void *block);
+
+/**
+ * Record a speaker edge.
+ *
+ * Samples are synthesised up to the given time at the old level, then the
+ * new level is latched. Called by the producer (game) thread only.
+ *
+ * \param[in] audio   Synthesiser.
+ * \param[in] tstates Virtual clock time of the edge.
+ * \param[in] level   New speaker level (0 or 1).
+ */
+void zxaudio_speaker(zxaudio_t *audio, uint64_t tstates, int level);
+
+/**
+ * Synthesise samples at the current speaker level up to the given time.
+ *
+ * Samples which don't fit into the ring buffer are dropped: the producer
+ * never waits for the consumer.
+ *
+ * \param[in] audio   Synthesiser.
+ * \param[in] tstates Virtual clock time to advance to.
+ */
+void zxaudio_advance(zxaudio_t *audio, uint64_t tstates);
+
+/**
+ * Fetch synthesised samples. Called by the consumer (frontend) thread only.
+ *
+ * \param[in]  audio    Synthesiser.
+ * \param[out] samples  Buffer to receive samples.
+ * \param[in]  nsamples Size of the buffer, in samples.
+ *
+ * \return Number of samples fetched.
+ */
+int zxaudio_read(zxaudio_t *audio, int16_t *samples, int nsamples);
+
+/**
+ * Build a header for a WAV file holding ZXAUDIO_SAMPLE_RATE 16-bit mono
+ * little-endian samples.
+ *
+ * To dump a stream, write a header with nsamples of zero, append samples as
+ * they're read, then rewind and write the header again with the real count.
+ *
+ * \param[out] header   Buffer to receive the header.
+ * \param[in]  nsamples Number of samples which follow the header.
+ */
+void zxaudio_wav_header(uint8_t header[ZXAUDIO_WAV_HEADER_LENGTH],
+                        uint32_t nsamples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZXSPECTRUM_AUDIO_H */
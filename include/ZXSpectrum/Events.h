@@ -0,0 +1,144 @@
+/* ZXEvents.h
+ *
+ * ZX Spectrum input event queue.
+ *
+ * Copyright (c) David Thomas, 2016. <dave@davespace.co.uk>
+ */
+
+#ifndef ZXSPECTRUM_EVENTS_H
+#define ZXSPECTRUM_EVENTS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Identifiers of input event types.
+ */
+typedef enum zxeventtype
+{
+  zxeventtype_KEY,     /**< index is a zxkey_t */
+  zxeventtype_KEMPSTON /**< index is a zxkempston_t */
+}
+zxeventtype_t;
+
+/**
+ * Identifiers of Kempston joystick directions. Values are bit numbers in
+ * port_KEMPSTON_JOYSTICK.
+ */
+typedef enum zxkempston
+{
+  zxkempston_RIGHT,
+  zxkempston_LEFT,
+  zxkempston_DOWN,
+  zxkempston_UP,
+  zxkempston_FIRE
+}
+zxkempston_t;
+
+/**
+ * A key or joystick transition.
+ */
+typedef struct zxevent
+{
+  uint32_t timestamp; /**< Frontend time of the event, e.g. in ms */
+  uint8_t  type;      /**< zxeventtype_t */
+  uint8_t  index;     /**< Key or direction */
+  uint8_t  down;      /**< Non-zero if pressed, zero if released */
+}
+zxevent_t;
+
+/**
+ * A single-producer, single-consumer queue of input events.
+ */
+typedef struct zxevents zxevents_t;
+
+/**
+ * Create an event queue.
+ *
+ * \return New queue, or NULL if out of memory.
+ */
+zxevents_t *zxevents_create(void);
+
+/**
+ * Destroy an event queue.
+ *
+ * \param[in] doomed Doomed queue.
+ */
+void zxevents_destroy(zxevents_t *doomed);
+
+/**
+ * Return the number of bytes an event queue occupies.
+ *
+ * \return Size of a queue, in bytes.
+ */
+size_t zxevents_footprint(void);
+
+/**
+ * Initialise an event queue in caller-supplied memory.
+ *
+ * \param[in] block Memory of at least zxevents_footprint() bytes, aligned
+ *                  to at least a pointer.
+ *
+ * \return Queue (at block), or NULL if it could not be initialised.
+ */
+zxevents_t *zxevents_init(void *block);
+
+/**
+ * Finalise an event queue made by zxevents_init(). Its memory is left to
+ * the caller.
+ *
+ * \param[in] events Queue.
+ */
+void zxevents_finalise(zxevents_t *events);
+
+/**
+ * Add an event to the queue. Called by the producer (frontend) thread only.
+ * Lock-free, except that it takes a lock to wake a consumer blocked in
+ * zxevents_wait().
+ *
+ * \param[in] events Queue.
+ * \param[in] event  Event to copy in.
+ *
+ * \return Non-zero if queued, zero if the queue was full.
+ */
+int zxevents_push(zxevents_t *events, const zxevent_t *event);
+
+/**
+ * Return the oldest event in the queue without removing it. Called by the
+ * consumer (game) thread only.
+ *
+ * \param[in] events Queue.
+ *
+ * \return Oldest event, or NULL if the queue is empty.
+ */
+const zxevent_t *zxevents_peek(zxevents_t *events);
+
+/**
+ * Remove the oldest event from the queue. Called by the consumer (game)
+ * thread only, after zxevents_peek() returned non-NULL.
+ *
+ * \param[in] events Queue.
+ */
+void zxevents_pop(zxevents_t *events);
+
+/**
+ * Block until an event is queued or the timeout expires. Called by the
+ * consumer (game) thread only. Uses no CPU while waiting.
+ *
+ * \param[in] events  Queue.
+ * \param[in] timeout Longest time to wait, in microseconds.
+ *
+ * \return Non-zero if an event is queued, zero if timed out.
+ */
+int zxevents_wait(zxevents_t *events, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZXSPECTRUM_EVENTS_H */
@@ -8,6 +8,8 @@
 #ifndef ZXSPECTRUM_KEYBOARD_H
 #define ZXSPECTRUM_KEYBOARD_H
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -89,6 +91,13 @@ void zxkeyset_assign(zxkeyset_t *keystate,
  */
 int zxkeyset_for_port(uint16_t port, zxkeyset_t keystate);
 
+/**
+ * Convert the given character to a zxkey_t.
+ *
+ * \return Key, or zxkey_UNKNOWN if the character has no key.
+ */
+zxkey_t zxkey_for_char(int c);
+
 /**
  * Mark the given character c as a held down key.
  */
@@ -0,0 +1,122 @@
+/* ZXPacer.h
+ *
+ * ZX Spectrum frame pacing.
+ *
+ * Copyright (c) David Thomas, 2016. <dave@davespace.co.uk>
+ */
+
+#ifndef ZXSPECTRUM_PACER_H
+#define ZXSPECTRUM_PACER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+/**
+ * Frame time and jitter statistics.
+ *
+ * Percentile arrays hold the 50th, 95th and 99th percentiles, in
+ * microseconds.
+ */
+typedef struct zxpacerstats
+{
+  unsigned int frames;          /**< Paced frames measured */
+  unsigned int skipped;         /**< Frames which skipped rendering */
+  int          frame_time[3];   /**< Time from frame start to frame start */
+  int          jitter[3];       /**< Deviation of frame time from target */
+}
+zxpacerstats_t;
+
+/**
+ * A frame pacer.
+ */
+typedef struct zxpacer zxpacer_t;
+
+/**
+ * Create a frame pacer.
+ *
+ * \param[in] rate Target frames per second.
+ *
+ * \return New pacer, or NULL if out of memory.
+ */
+zxpacer_t *zxpacer_create(int rate);
+
+/**
+ * Destroy a frame pacer.
+ *
+ * \param[in] doomed Doomed pacer.
+ */
+void zxpacer_destroy(zxpacer_t *doomed);
+
+/**
+ * Return the number of bytes a frame pacer occupies.
+ *
+ * \return Size of a pacer, in bytes.
+ */
+size_t zxpacer_footprint(void);
+
+/**
+ * Initialise a frame pacer in caller-supplied memory. It needs no
+ * finalisation.
+ *
+ * \param[in] block Memory of at least zxpacer_footprint() bytes, aligned to
+ *                  at least eight bytes.
+ * \param[in] rate  Target frames per second.
+ *
+ * \return Pacer (at block).
+ */
+zxpacer_t *zxpacer_init(void *block, int rate);
+
+/**
+ * Return the target frame period.
+ *
+ * \param[in] pacer Pacer.
+ *
+ * \return Frame period in microseconds.
+ */
+int zxpacer_period(const zxpacer_t *pacer);
+
+/**
+ * Call when a frame's work is done, before presenting it.
+ *
+ * Works out how long to wait until the frame's deadline and whether the
+ * next frame should skip rendering to catch up.
+ *
+ * \param[in]  pacer Pacer.
+ * \param[out] wait  Microseconds to wait before starting the next frame.
+ *
+ * \return Non-zero if the next frame should skip rendering.
+ */
+int zxpacer_end_frame(zxpacer_t *pacer, int *wait);
+
+/**
+ * Call after waiting, when the next frame starts.
+ *
+ * \param[in] pacer Pacer.
+ */
+void zxpacer_start_frame(zxpacer_t *pacer);
+
+/**
+ * Forget the current deadline, e.g. after the game has waited for input.
+ * The next frame is neither delayed, skipped nor measured.
+ *
+ * \param[in] pacer Pacer.
+ */
+void zxpacer_resync(zxpacer_t *pacer);
+
+/**
+ * Fetch frame time and jitter statistics.
+ *
+ * \param[in]  pacer Pacer.
+ * \param[out] stats Statistics.
+ */
+void zxpacer_get_stats(const zxpacer_t *pacer, zxpacerstats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZXSPECTRUM_PACER_H */
@@ -13,12 +13,22 @@ extern "C"
 {
 #endif
 
-  /**
- * Build conversion tables.
- *
- * Can be called multiple times.
+/** Length of screen bitmap memory, in bytes. */
+#define ZXSCREEN_BITMAP_LENGTH 6144
+
+/** Length of screen bitmap plus attribute memory, in bytes. */
+#define ZXSCREEN_LENGTH        (6144 + 768)
+
+/**
+ * Identifiers of screen bitmap layouts. Attributes are laid out the same
+ * way in both.
  */
-void zxscreen_initialise(void);
+typedef enum zxlayout
+{
+  zxlayout_SPECTRUM, /**< Interleaved thirds, as on the real machine */
+  zxlayout_LINEAR    /**< 192 scanlines of 32 bytes, top to bottom */
+}
+zxlayout_t;
 
 /**
  * Convert the given screen into 0x00BBGGRR pixel format (or 0x00RRGGBB on Windows).
@@ -28,6 +38,36 @@ void zxscreen_initialise(void);
  */
 void zxscreen_convert(const void *screen, unsigned int *output);
 
+/**
+ * Convert the given linear layout screen into 0x00BBGGRR pixel format (or
+ * 0x00RRGGBB on Windows).
+ *
+ * \param[in] screen ZX Spectrum screen data, in zxlayout_LINEAR.
+ * \param[in] output Output screen pixels.
+ */
+void zxscreen_convert_linear(const void *screen, unsigned int *output);
+
+/**
+ * Convert only the 8x8 cells of the given screen whose bitmap or attribute
+ * differs from a shadow copy of what output last showed, then update the
+ * shadow. When most cells differ, the whole screen is converted instead
+ * using zxscreen_convert() or zxscreen_convert_linear().
+ *
+ * A zeroed shadow matches a zeroed (all black) output.
+ *
+ * \param[in]     screen ZX Spectrum screen data.
+ * \param[in]     layout Layout of the screen data.
+ * \param[in,out] shadow Copy of the screen data output was converted from,
+ *                       ZXSCREEN_LENGTH bytes.
+ * \param[in,out] output Output screen pixels.
+ *
+ * \return Number of cells converted.
+ */
+int zxscreen_convert_changed(const void   *screen,
+                             zxlayout_t    layout,
+                             void         *shadow,
+                             unsigned int *output);
+
 #ifdef __cplusplus
 }
 #endif
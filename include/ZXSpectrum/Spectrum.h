@@ -13,8 +13,13 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "ZXSpectrum/Events.h"
+#include "ZXSpectrum/Pacer.h"
+#include "ZXSpectrum/Screen.h"
+
 /**
  * Identifiers of screen attributes.
  */
@@ -47,6 +52,7 @@ typedef uint8_t attribute_t;
 enum
 {
   port_KEMPSTON_JOYSTICK        = 0x001F, /* 000FUDLR / active bits high */
+  port_FULLER_JOYSTICK          = 0x007F, /* F---RLDU / active bits low */
 
   port_BORDER                   = 0x00FE, /* Border, Ear, Mic */
 
@@ -85,11 +91,34 @@ typedef enum
 {
   sleeptype_MENU,
   sleeptype_SOUND,
-  sleeptype_KEYSCAN,
-  sleeptype_DELAY
+  sleeptype_KEYSCAN, /* waiting for input: may end early on an event */
+  sleeptype_DELAY,
+  sleeptype_FRAME  /* waiting for the frame pacer's deadline */
 }
 sleeptype_t;
 
+/**
+ * A snapshot of the input ports.
+ *
+ * The snapshot is latched when the game ends a frame and when it sleeps
+ * waiting for input (sleeptype_MENU and sleeptype_KEYSCAN). Everything read
+ * in between sees the same inputs. Posted events are applied at the same
+ * points.
+ */
+typedef struct zxinput
+{
+  /** Keyboard half-rows, active low. Indexed by the bit which is clear in
+   * the port's high byte, so keyboard[0] is port_KEYBOARD_SHIFTZXCV. */
+  uint8_t keyboard[8];
+
+  /** Kempston joystick, as port_KEMPSTON_JOYSTICK. */
+  uint8_t kempston;
+
+  /** Fuller joystick, as port_FULLER_JOYSTICK. */
+  uint8_t fuller;
+}
+zxinput_t;
+
 /**
  * The current state of the machine.
  */
@@ -106,15 +135,39 @@ struct zxspectrum
   void (*out)(zxspectrum_t *state, uint16_t address, uint8_t byte);
   
   /**
-   * Call the implementer when screen or attributes have changed.
+   * Call the implementer when screen or attributes have changed. Only
+   * presents: input stays latched until the frame ends.
    */
   void (*kick)(zxspectrum_t *state /*, changedbox */);
 
+  /**
+   * Call the implementer at the end of each game frame. Presents the frame
+   * as kick does then, if paced, waits for the frame's deadline, then latches
+   * input for the next frame. Kicks made mid-frame are never paced.
+   */
+  void (*end_frame)(zxspectrum_t *state);
+
   /**
    * Call the implementer when we need to sleep.
    */
   void (*sleep)(zxspectrum_t *state, sleeptype_t type, int duration);
 
+  /**
+   * Inputs latched for the current frame. Read using zxinput_read().
+   */
+  zxinput_t   input;
+
+  /**
+   * Non-zero when the frame pacer has fallen behind and the current frame
+   * should skip rendering. The game may then skip drawing to the screen.
+   * kick and end_frame won't convert or present it.
+   */
+  int         frame_skip;
+
+  /**
+   * Layout of screen[]. Fixed when the machine is created.
+   */
+  zxlayout_t  layout;
 
   uint8_t     screen[SCREEN_LENGTH];
   // if a gap appears here then ZXScreen will break!
@@ -129,23 +182,82 @@ typedef struct zxconfig
   /** An opaque pointer passed into callbacks. */
   void *opaque;
   
-  /** Called when there's a new frame to draw. */
+  /** Called when there's a new frame to draw. pixels is only valid for the
+   * duration of the call: to present later, or from another thread, use
+   * zxspectrum_claim_screen(). */
   void (*draw)(unsigned int *pixels, void *opaque);
 
-  /** Called when there's nothing to do. */
+  /** Called when there's nothing to do. Not called for sound delays. */
   void (*sleep)(int duration, sleeptype_t sleeptype, void *opaque);
   
-  /** Called when a key is tested. */
+  /** Called when input is latched, once for each keyboard half-row. The
+   * result is combined with keys posted using zxspectrum_post_event(). May
+   * be NULL if the frontend only posts events. */
   int (*key)(uint16_t port, void *opaque);
+
+  /** Frames per second to pace the game to, or zero to leave the game
+   * unpaced. When paced, end_frame waits (sleeptype_FRAME) until each
+   * frame's deadline and the game's own delays (sleeptype_DELAY) are
+   * skipped. */
+  int frame_rate;
+
+  /** Layout of the screen bitmap. zxlayout_SPECTRUM gives the real
+   * machine's interleaved layout. zxlayout_LINEAR stores scanlines in order,
+   * which is cheaper to address and to convert, but then the screen no
+   * longer matches a real Spectrum's memory. */
+  zxlayout_t layout;
 }
 zxconfig_t;
 
+/**
+ * Alignment required of blocks passed to zxspectrum_create_in(), in bytes.
+ * A cache line.
+ */
+#define ZXSPECTRUM_ALIGNMENT 64
+
+/**
+ * Size of the static block which zxspectrum_create() uses in builds with
+ * ZXSPECTRUM_NO_HEAP defined. Override it at build time if creation fails.
+ */
+#ifndef ZXSPECTRUM_STATIC_FOOTPRINT
+#define ZXSPECTRUM_STATIC_FOOTPRINT (704 * 1024)
+#endif
+
 /**
  * Create a logical ZX Spectrum.
  *
- * \return New ZXSpectrum.
+ * The machine occupies a single block of zxspectrum_footprint() bytes. In
+ * builds with ZXSPECTRUM_NO_HEAP defined that block is static, so only one
+ * machine created this way may exist at a time.
+ *
+ * \return New ZXSpectrum, or NULL on failure.
  */
 zxspectrum_t *zxspectrum_create(const zxconfig_t *config);
+
+/**
+ * Return the number of bytes a logical ZX Spectrum occupies.
+ *
+ * \param[in] config Configuration, as will be passed to create.
+ *
+ * \return Size of the machine's block, in bytes.
+ */
+size_t zxspectrum_footprint(const zxconfig_t *config);
+
+/**
+ * Create a logical ZX Spectrum in caller-supplied memory.
+ *
+ * Everything the machine uses is laid out within block, which the caller
+ * still owns once the machine is destroyed.
+ *
+ * \param[in] config Configuration.
+ * \param[in] block  Memory aligned to ZXSPECTRUM_ALIGNMENT.
+ * \param[in] size   Size of block, at least zxspectrum_footprint() bytes.
+ *
+ * \return New ZXSpectrum (at block), or NULL on failure.
+ */
+zxspectrum_t *zxspectrum_create_in(const zxconfig_t *config,
+                                   void             *block,
+                                   size_t            size);
  
 /**
  * Destroy a logical ZX Spectrum.
@@ -154,6 +266,92 @@ zxspectrum_t *zxspectrum_create(const zxconfig_t *config);
  */
 void zxspectrum_destroy(zxspectrum_t *doomed);
 
+/**
+ * Read an input port from a snapshot.
+ *
+ * Keyboard ports which select several half-rows return their combination,
+ * as on the real machine.
+ *
+ * \param[in] input Input snapshot.
+ * \param[in] port  Port number.
+ *
+ * \return Port value.
+ */
+uint8_t zxinput_read(const zxinput_t *input, uint16_t port);
+
+/**
+ * Post a key or joystick transition.
+ *
+ * Events are queued and applied, in order, the next time input is latched.
+ * A key pressed and released between two latches is held down for one latch
+ * so that quick taps are not lost. Safe to call from one thread other than
+ * the one running the game.
+ *
+ * Posting is lock-free unless the game is blocked in
+ * zxspectrum_wait_for_event(). Only then is a lock taken, to wake it.
+ *
+ * \param[in] state ZXSpectrum.
+ * \param[in] event Event.
+ *
+ * \return Non-zero if posted, zero if the queue was full.
+ */
+int zxspectrum_post_event(zxspectrum_t *state, const zxevent_t *event);
+
+/**
+ * Block until an event is posted or the timeout expires.
+ *
+ * For the frontend's sleep handler to use when the game waits for input
+ * (sleeptype_KEYSCAN). The wait uses no CPU and ends as soon as an event is
+ * posted, so the game sees the key without waiting out the whole duration.
+ * Input is latched when the sleep handler returns. Call from the thread
+ * running the game only.
+ *
+ * \param[in] state   ZXSpectrum.
+ * \param[in] timeout Longest time to wait, in microseconds.
+ *
+ * \return Non-zero if an event is pending, zero if timed out.
+ */
+int zxspectrum_wait_for_event(zxspectrum_t *state, int timeout);
+
+/**
+ * Claim the latest complete converted screen for presentation.
+ *
+ * Frames are triple buffered: the game never waits for the presenter and
+ * the presenter never sees a frame which is still being converted. Safe to
+ * call from one thread other than the one running the game.
+ *
+ * \param[in] state ZXSpectrum.
+ *
+ * \return Pixels, valid until the next call.
+ */
+const unsigned int *zxspectrum_claim_screen(zxspectrum_t *state);
+
+/**
+ * Fetch frame pacer statistics.
+ *
+ * \param[in]  state ZXSpectrum.
+ * \param[out] stats Statistics. Zeroed if the game is unpaced.
+ */
+void zxspectrum_get_pacer_stats(zxspectrum_t *state, zxpacerstats_t *stats);
+
+/**
+ * Fetch synthesised beeper audio.
+ *
+ * Output is ZXAUDIO_SAMPLE_RATE 16-bit mono samples (see Audio.h). Speaker
+ * edges are timestamped against a virtual clock advanced by sleeps, so audio
+ * is produced even when nothing is being played in real time. Safe to call
+ * from a thread other than the one running the game.
+ *
+ * \param[in]  state    ZXSpectrum.
+ * \param[out] samples  Buffer to receive samples.
+ * \param[in]  nsamples Size of the buffer, in samples.
+ *
+ * \return Number of samples fetched.
+ */
+int zxspectrum_read_audio(zxspectrum_t *state,
+                          int16_t      *samples,
+                          int           nsamples);
+
 #ifdef __cplusplus
 }
 #endif
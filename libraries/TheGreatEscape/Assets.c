@@ -0,0 +1,506 @@
+/* Assets.c
+ *
+ * Asset packs: the graphics and level data in a form which can be mapped
+ * into memory and shared between processes.
+ *
+ * A pack is a header followed by sections, each aligned to TGE_ALIGNMENT.
+ * It's written in the native byte order of the machine which made it, and
+ * holds the same data as the compiled-in arrays, plus the masks decoded
+ * ready for use.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L /* for mmap */
+#endif
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "TheGreatEscape/Assets.h"
+#include "TheGreatEscape/ExteriorTiles.h"
+#include "TheGreatEscape/InteriorTiles.h"
+#include "TheGreatEscape/Map.h"
+#include "TheGreatEscape/Masks.h"
+#include "TheGreatEscape/SuperTiles.h"
+#include "TheGreatEscape/Tiles.h"
+#include "TheGreatEscape/Utils.h"
+#include "TheGreatEscape/TheGreatEscape.h"
+
+/* Change this whenever the layout or the content of a pack changes. */
+#define PACK_VERSION 2
+
+#define PACK_BYTEORDER 0x01020304u
+
+/* Round up to a multiple of TGE_ALIGNMENT. */
+#define ALIGN_UP(n) (((n) + TGE_ALIGNMENT - 1) & ~(size_t) (TGE_ALIGNMENT - 1))
+
+/** Pack sections, in the order they're stored. */
+enum
+{
+  section_MASK_TILES,
+  section_EXTERIOR_TILES, /* all three sets */
+  section_INTERIOR_TILES,
+  section_SUPERTILES,
+  section_MAP,
+  section_EXTERIOR_MASK_DATA,
+  section_MASKS,
+  section__LIMIT
+};
+
+typedef struct packsection
+{
+  uint32_t offset; /**< from the start of the pack */
+  uint32_t length;
+}
+packsection_t;
+
+typedef struct packheader
+{
+  char          magic[8];  /**< "TGEPACK" */
+  uint32_t      byteorder; /**< PACK_BYTEORDER */
+  uint32_t      version;   /**< PACK_VERSION */
+  uint32_t      nsections; /**< section__LIMIT */
+  uint32_t      length;    /**< of the whole pack */
+  packsection_t sections[section__LIMIT];
+}
+packheader_t;
+
+static const char pack_magic[8] = "TGEPACK";
+
+/** The number of masks. */
+#define MASKS_LENGTH NELEMS(mask_pointers)
+
+/** The largest number of tiles in a decoded mask: width and height are
+ * bytes. */
+#define MASK_TILES_MAX (255 * 255)
+
+/* ----------------------------------------------------------------------- */
+
+static const tgeassets_t builtin_assets =
+{
+  &mask_tiles[0],
+  {
+    &exterior_tiles[0],
+    &exterior_tiles[exterior_tiles_1_LENGTH],
+    &exterior_tiles[exterior_tiles_1_LENGTH + exterior_tiles_2_LENGTH]
+  },
+  &interior_tiles[0],
+  &supertiles[0],
+  &map[0],
+  &exterior_mask_data[0],
+  NULL /* masks are decoded as they're drawn */
+};
+
+const tgeassets_t *assets = &builtin_assets;
+
+/* The mapped pack, if any. */
+static tgeassets_t  mapped_assets;
+static const void  *mapped_base;
+static size_t       mapped_length;
+
+/* ----------------------------------------------------------------------- */
+
+/**
+ * Decode an RLE mask from mask_pointers into tile indices.
+ *
+ * \param[in]  index  Mask index.
+ * \param[out] output Tile indices, or NULL to just count them.
+ *
+ * \return Number of tile indices.
+ */
+static size_t decode_mask(int index, uint8_t *output)
+{
+  const uint8_t *data;
+  const uint8_t *end;
+  uint8_t        byte;
+  int            run;
+  size_t         count;
+
+  data  = mask_pointers[index] + 1; /* skip width */
+  end   = mask_pointers[index] + mask_lengths[index];
+  count = 0;
+  while (data < end)
+  {
+    byte = *data++;
+    run  = 1;
+    if (byte & (1 << 7))
+    {
+      run  = byte & 0x7F;
+      byte = *data++;
+    }
+    while (run--)
+    {
+      if (output)
+        output[count] = byte;
+      count++;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Write data to a file followed by zeroes up to the padded length.
+ */
+static int write_padded(FILE *f, const void *data, size_t length, size_t padded)
+{
+  static const uint8_t zeroes[TGE_ALIGNMENT];
+
+  if (length && fwrite(data, 1, length, f) != length)
+    return 0;
+  if (padded > length && fwrite(zeroes, 1, padded - length, f) != padded - length)
+    return 0;
+  return 1;
+}
+
+TGE_API int tge_write_assets(const char *path)
+{
+  static uint8_t tiles[MASK_TILES_MAX];
+
+  const void     *data[section__LIMIT];
+  expandedmask_t  masks[MASKS_LENGTH];
+  packheader_t    header;
+  size_t          offset;
+  size_t          length;
+  size_t          count;
+  int             i;
+  FILE           *f;
+
+  assert(path != NULL);
+
+  /* The masks section is a table of the decoded masks followed by all of
+   * their tile indices. */
+  offset = sizeof(masks);
+  for (i = 0; i < MASKS_LENGTH; i++)
+  {
+    count = decode_mask(i, NULL);
+    masks[i].offset = (uint32_t) offset;
+    masks[i].width  = mask_pointers[i][0];
+    masks[i].height = (uint8_t) (count / masks[i].width);
+    masks[i].unused = 0;
+    assert(count == (size_t) masks[i].width * masks[i].height);
+    offset += count;
+  }
+
+  data[section_MASK_TILES]         = &mask_tiles[0];
+  data[section_EXTERIOR_TILES]     = &exterior_tiles[0];
+  data[section_INTERIOR_TILES]     = &interior_tiles[0];
+  data[section_SUPERTILES]         = &supertiles[0];
+  data[section_MAP]                = &map[0];
+  data[section_EXTERIOR_MASK_DATA] = &exterior_mask_data[0];
+  data[section_MASKS]              = &masks[0];
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, pack_magic, sizeof(header.magic));
+  header.byteorder = PACK_BYTEORDER;
+  header.version   = PACK_VERSION;
+  header.nsections = section__LIMIT;
+
+  header.sections[section_MASK_TILES].length         = sizeof(mask_tiles);
+  header.sections[section_EXTERIOR_TILES].length     = sizeof(exterior_tiles);
+  header.sections[section_INTERIOR_TILES].length     = sizeof(interior_tiles);
+  header.sections[section_SUPERTILES].length         = sizeof(supertiles);
+  header.sections[section_MAP].length                = sizeof(map);
+  header.sections[section_EXTERIOR_MASK_DATA].length = sizeof(exterior_mask_data);
+  header.sections[section_MASKS].length              = (uint32_t) offset;
+
+  offset = ALIGN_UP(sizeof(header));
+  for (i = 0; i < section__LIMIT; i++)
+  {
+    header.sections[i].offset = (uint32_t) offset;
+    offset += ALIGN_UP(header.sections[i].length);
+  }
+  header.length = (uint32_t) offset;
+
+  f = fopen(path, "wb");
+  if (f == NULL)
+    return 0;
+
+  if (!write_padded(f, &header, sizeof(header), ALIGN_UP(sizeof(header))))
+    goto failure;
+
+  for (i = 0; i < section__LIMIT - 1; i++)
+  {
+    length = header.sections[i].length;
+    if (!write_padded(f, data[i], length, ALIGN_UP(length)))
+      goto failure;
+  }
+
+  /* The masks section comes last. Its tile indices are written a mask at a
+   * time. */
+  if (!write_padded(f, masks, sizeof(masks), sizeof(masks)))
+    goto failure;
+  for (i = 0; i < MASKS_LENGTH; i++)
+  {
+    count = decode_mask(i, tiles);
+    if (!write_padded(f, tiles, count, count))
+      goto failure;
+  }
+  length = header.sections[section_MASKS].length;
+  if (!write_padded(f, NULL, 0, ALIGN_UP(length) - length))
+    goto failure;
+
+  if (fclose(f) != 0)
+    return 0;
+
+  return 1;
+
+
+failure:
+  fclose(f);
+  return 0;
+}
+
+/* ----------------------------------------------------------------------- */
+
+/**
+ * Check that every byte in an array of indices is below a limit.
+ *
+ * \param[in] indices Indices.
+ * \param[in] count   Number of indices.
+ * \param[in] limit   Number of entries in the table indexed.
+ *
+ * \return Non-zero if all are in range.
+ */
+static int indices_below(const uint8_t *indices, size_t count, size_t limit)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++)
+    if (indices[i] >= limit)
+      return 0;
+
+  return 1;
+}
+
+/**
+ * Return the number of exterior tiles a supertile may index: those from the
+ * start of its set to the end of the last set. The set follows the choice
+ * made by plot_tile and select_tile_set.
+ *
+ * \param[in] index Supertile index.
+ *
+ * \return Number of tiles.
+ */
+static size_t exterior_tiles_reach(supertileindex_t index)
+{
+  if (index < 45)
+    return exterior_tiles__LIMIT;
+  else if (index < 139 || index >= 204)
+    return exterior_tiles__LIMIT - exterior_tiles_1_LENGTH;
+  else
+    return exterior_tiles_3_LENGTH;
+}
+
+/**
+ * Check that a pack is well formed and matches this build.
+ *
+ * The renderer only asserts that the indices it reads are in range, so every
+ * index held in the pack is checked here, once, against the table it indexes.
+ *
+ * \param[in] base   Pack.
+ * \param[in] length Length of pack in bytes.
+ *
+ * \return Non-zero if the pack can be used.
+ */
+static int validate_pack(const uint8_t *base, size_t length)
+{
+  /* Section lengths which are fixed by this build. Zero if variable. */
+  static const size_t lengths[section__LIMIT] =
+  {
+    sizeof(mask_tiles),
+    sizeof(exterior_tiles),
+    sizeof(interior_tiles),
+    sizeof(supertiles),
+    sizeof(map),
+    sizeof(exterior_mask_data),
+    0
+  };
+
+  const packheader_t   *header = (const packheader_t *) base;
+  const packsection_t  *section;
+  const expandedmask_t *masks;
+  const supertile_t    *supertiles;
+  const mask_t         *exterior_masks;
+  int                   i;
+
+  if (length < sizeof(*header) ||
+      memcmp(header->magic, pack_magic, sizeof(header->magic)) != 0 ||
+      header->byteorder != PACK_BYTEORDER ||
+      header->version   != PACK_VERSION ||
+      header->nsections != section__LIMIT ||
+      header->length    != length)
+    return 0;
+
+  for (i = 0; i < section__LIMIT; i++)
+  {
+    section = &header->sections[i];
+    if ((section->offset & (TGE_ALIGNMENT - 1)) != 0 ||
+        section->offset > length ||
+        section->length > length - section->offset)
+      return 0;
+    if (lengths[i] && section->length != lengths[i])
+      return 0;
+  }
+
+  /* Every decoded mask must lie within its section. */
+  section = &header->sections[section_MASKS];
+  if (section->length < MASKS_LENGTH * sizeof(*masks))
+    return 0;
+  masks = (const expandedmask_t *) (base + section->offset);
+  for (i = 0; i < MASKS_LENGTH; i++)
+    if (masks[i].offset < MASKS_LENGTH * sizeof(*masks) ||
+        masks[i].offset > section->length ||
+        (size_t) masks[i].width * masks[i].height > section->length - masks[i].offset)
+      return 0;
+
+  /* Every decoded mask must hold only mask tile indices. */
+  for (i = 0; i < MASKS_LENGTH; i++)
+    if (!indices_below((const uint8_t *) masks + masks[i].offset,
+                       (size_t) masks[i].width * masks[i].height,
+                       NELEMS(mask_tiles)))
+      return 0;
+
+  /* Every mask placement must name a mask and have ordered bounds, else
+   * render_mask_buffer's clipped spans underflow. */
+  exterior_masks = (const mask_t *) (base + header->sections[section_EXTERIOR_MASK_DATA].offset);
+  for (i = 0; i < NELEMS(exterior_mask_data); i++)
+    if (exterior_masks[i].index >= MASKS_LENGTH ||
+        exterior_masks[i].bounds.x0 > exterior_masks[i].bounds.x1 ||
+        exterior_masks[i].bounds.y0 > exterior_masks[i].bounds.y1)
+      return 0;
+
+  /* The map must hold only supertile indices. */
+  if (!indices_below(base + header->sections[section_MAP].offset,
+                     NELEMS(map),
+                     supertileindex__LIMIT))
+    return 0;
+
+  /* Every supertile must hold only indices within reach of its tile set. */
+  supertiles = (const supertile_t *) (base + header->sections[section_SUPERTILES].offset);
+  for (i = 0; i < supertileindex__LIMIT; i++)
+    if (!indices_below(&supertiles[i].tiles[0],
+                       NELEMS(supertiles[i].tiles),
+                       exterior_tiles_reach((supertileindex_t) i)))
+      return 0;
+
+  return 1;
+}
+
+static void unmap(const void *base, size_t length)
+{
+#ifdef _WIN32
+  (void) length;
+  UnmapViewOfFile(base);
+#else
+  munmap((void *) base, length);
+#endif
+}
+
+TGE_API int tge_load_assets(const char *path)
+{
+  const uint8_t      *base;
+  size_t              length;
+  const packheader_t *header;
+#ifdef _WIN32
+  HANDLE              file;
+  HANDLE              mapping;
+  LARGE_INTEGER       size;
+#else
+  int                 fd;
+  struct stat         st;
+  void               *p;
+#endif
+
+  assert(path != NULL);
+
+#ifdef _WIN32
+  file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                     OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return 0;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || size.HighPart)
+  {
+    CloseHandle(file);
+    return 0;
+  }
+  length  = (size_t) size.QuadPart;
+  mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(file);
+  if (mapping == NULL)
+    return 0;
+  base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping); // the view keeps the mapping alive
+  if (base == NULL)
+    return 0;
+#else
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return 0;
+  if (fstat(fd, &st) < 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return 0;
+  }
+  length = (size_t) st.st_size;
+  p = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd); // the mapping keeps the file open
+  if (p == MAP_FAILED)
+    return 0;
+  base = p;
+#endif
+
+  if (!validate_pack(base, length))
+  {
+    unmap(base, length);
+    return 0;
+  }
+
+  tge_unload_assets();
+
+  header = (const packheader_t *) base;
+
+#define SECTION(type, name) ((const type *) (base + header->sections[section_##name].offset))
+  mapped_assets.mask_tiles         = SECTION(tile_t,           MASK_TILES);
+  mapped_assets.exterior_tiles[0]  = SECTION(tile_t,           EXTERIOR_TILES);
+  mapped_assets.exterior_tiles[1]  = mapped_assets.exterior_tiles[0] + exterior_tiles_1_LENGTH;
+  mapped_assets.exterior_tiles[2]  = mapped_assets.exterior_tiles[1] + exterior_tiles_2_LENGTH;
+  mapped_assets.interior_tiles     = SECTION(tile_t,           INTERIOR_TILES);
+  mapped_assets.supertiles         = SECTION(supertile_t,      SUPERTILES);
+  mapped_assets.map                = SECTION(supertileindex_t, MAP);
+  mapped_assets.exterior_mask_data = SECTION(mask_t,           EXTERIOR_MASK_DATA);
+  mapped_assets.masks              = SECTION(expandedmask_t,   MASKS);
+#undef SECTION
+
+  mapped_base   = base;
+  mapped_length = length;
+  assets        = &mapped_assets;
+
+  return 1;
+}
+
+TGE_API void tge_unload_assets(void)
+{
+  assets = &builtin_assets;
+
+  if (mapped_base == NULL)
+    return;
+
+  unmap(mapped_base, mapped_length);
+  mapped_base   = NULL;
+  mapped_length = 0;
+}
+
+// vim: ts=8 sts=2 sw=2 et
@@ -1,12 +1,117 @@
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "TheGreatEscape/State.h"
 
+#include "TheGreatEscape/Main.h"
 #include "TheGreatEscape/Messages.h"
+#include "TheGreatEscape/RoomDefs.h"
 #include "TheGreatEscape/TheGreatEscape.h"
+#include "TheGreatEscape/Utils.h"
+
+/* Round up to a multiple of TGE_ALIGNMENT. */
+#define ALIGN_UP(n) (((n) + TGE_ALIGNMENT - 1) & ~(size_t) (TGE_ALIGNMENT - 1))
+
+/* Dimensions of the window buffer. The game screen is assumed to be one
+ * smaller in both dimensions. That is a 24x17 buffer is displayed through a
+ * 23x16 window on-screen. This allows for rolling/scrolling. */
+#define COLUMNS    24
+#define ROWS       17
+
+/* Dimensions of the supertile map buffer. This is held separately, rather
+ * than computed from columns and rows, as it's wider than I expected it to
+ * be. */
+#define ST_COLUMNS 7
+#define ST_ROWS    5
+
+/* Offsets of the buffers within an instance's block. The state itself comes
+ * first. */
+typedef struct tgelayout
+{
+  size_t tile_buf;
+  size_t window_buf;
+  size_t map_buf;
+  size_t total;
+}
+tgelayout_t;
+
+#define LAYOUT_TOTAL(columns, rows, st_columns, st_rows)                   \
+  (ALIGN_UP(sizeof(tgestate_t)) +                                          \
+   ALIGN_UP((size_t) ((columns) * (rows)) * sizeof(tileindex_t)) +         \
+   ALIGN_UP((size_t) ((columns) * (rows) * 8)) +                           \
+   ALIGN_UP((size_t) ((st_columns) * (st_rows)) * sizeof(supertileindex_t)))
+
+/* Size of an instance's block. */
+#define FOOTPRINT LAYOUT_TOTAL(COLUMNS, ROWS, ST_COLUMNS, ST_ROWS)
+
+/* The fields used on every frame must stay within their budget. */
+STATIC_ASSERT(offsetof(tgestate_t, cold) <= TGESTATE_HOT_BUDGET, state_hot_budget);
+
+#ifdef TGE_NO_HEAP
+/* Block used by tge_create. Over-allocated so it can be aligned. */
+static unsigned char static_block[FOOTPRINT + TGE_ALIGNMENT - 1];
+static int           static_block_in_use;
+#endif
+
+enum
+{
+  template_EMPTY,
+  template_CAPTURING,
+  template_READY
+};
+
+/**
+ * Conv: Added. The state of the first instance to complete tge_setup, from
+ * which tge_reset restores instances. Immutable once ready.
+ */
+static struct
+{
+  volatile long status;   /* template_* */
+  uintptr_t     base;     /* address of the instance it was captured from */
+  uintptr_t     screen;   /* address of that instance's speccy->screen */
+  zxlayout_t    layout;   /* that instance's screen layout */
+  unsigned char block[FOOTPRINT];
+  uint8_t       screen_data[SCREEN_LENGTH + SCREEN_ATTRIBUTES_LENGTH];
+}
+template;
+
+/* $EDD3: Game screen start addresses. The game window starts at column 7
+ * of scanline 16.
+ *
+ * Conv: Absolute addresses in a table in the original code. These are now
+ * offsets, with one constant table for each screen layout. */
+#define SPECTRUM_OFFSET(line)                                              \
+  (((((16 + (line)) & 0xC0) << 5) |                                        \
+    (((16 + (line)) & 0x07) << 8) |                                        \
+    (((16 + (line)) & 0x38) << 2)) + 7)
+#define LINEAR_OFFSET(line) ((16 + (line)) * 32 + 7)
+
+#define OFFSETS4(F, i)  F(i), F(i + 1), F(i + 2), F(i + 3)
+#define OFFSETS16(F, i) OFFSETS4(F, i), OFFSETS4(F, i + 4), OFFSETS4(F, i + 8), OFFSETS4(F, i + 12)
+#define OFFSETS64(F, i) OFFSETS16(F, i), OFFSETS16(F, i + 16), OFFSETS16(F, i + 32), OFFSETS16(F, i + 48)
+
+#define GAME_WINDOW_LINES ((ROWS - 1) * 8)
+
+static const uint16_t spectrum_game_window_start_offsets[GAME_WINDOW_LINES] =
+{
+  OFFSETS64(SPECTRUM_OFFSET, 0), OFFSETS64(SPECTRUM_OFFSET, 64)
+};
+
+static const uint16_t linear_game_window_start_offsets[GAME_WINDOW_LINES] =
+{
+  OFFSETS64(LINEAR_OFFSET, 0), OFFSETS64(LINEAR_OFFSET, 64)
+};
+
+STATIC_ASSERT(GAME_WINDOW_LINES == 128, game_window_lines);
+
+#undef OFFSETS64
+#undef OFFSETS16
+#undef OFFSETS4
+#undef LINEAR_OFFSET
+#undef SPECTRUM_OFFSET
 
 /**
  * Initialise the game state.
@@ -213,149 +318,32 @@ static void tge_initialise(tgestate_t *state)
     { { 0x3C, 0x4C }, 0x20, direction_BOTTOM_RIGHT, 0, &movement_0[0] },
   };
 
-  /**
-   * $EDD3: Game screen start addresses.
-   *
-   * Absolute addresses in the original code. These are now offsets.
-   */
-  static const uint16_t game_window_start_offsets[128] =
-  {
-    0x0047,
-    0x0147,
-    0x0247,
-    0x0347,
-    0x0447,
-    0x0547,
-    0x0647,
-    0x0747,
-    0x0067,
-    0x0167,
-    0x0267,
-    0x0367,
-    0x0467,
-    0x0567,
-    0x0667,
-    0x0767,
-    0x0087,
-    0x0187,
-    0x0287,
-    0x0387,
-    0x0487,
-    0x0587,
-    0x0687,
-    0x0787,
-    0x00A7,
-    0x01A7,
-    0x02A7,
-    0x03A7,
-    0x04A7,
-    0x05A7,
-    0x06A7,
-    0x07A7,
-    0x00C7,
-    0x01C7,
-    0x02C7,
-    0x03C7,
-    0x04C7,
-    0x05C7,
-    0x06C7,
-    0x07C7,
-    0x00E7,
-    0x01E7,
-    0x02E7,
-    0x03E7,
-    0x04E7,
-    0x05E7,
-    0x06E7,
-    0x07E7,
-    0x0807,
-    0x0907,
-    0x0A07,
-    0x0B07,
-    0x0C07,
-    0x0D07,
-    0x0E07,
-    0x0F07,
-    0x0827,
-    0x0927,
-    0x0A27,
-    0x0B27,
-    0x0C27,
-    0x0D27,
-    0x0E27,
-    0x0F27,
-    0x0847,
-    0x0947,
-    0x0A47,
-    0x0B47,
-    0x0C47,
-    0x0D47,
-    0x0E47,
-    0x0F47,
-    0x0867,
-    0x0967,
-    0x0A67,
-    0x0B67,
-    0x0C67,
-    0x0D67,
-    0x0E67,
-    0x0F67,
-    0x0887,
-    0x0987,
-    0x0A87,
-    0x0B87,
-    0x0C87,
-    0x0D87,
-    0x0E87,
-    0x0F87,
-    0x08A7,
-    0x09A7,
-    0x0AA7,
-    0x0BA7,
-    0x0CA7,
-    0x0DA7,
-    0x0EA7,
-    0x0FA7,
-    0x08C7,
-    0x09C7,
-    0x0AC7,
-    0x0BC7,
-    0x0CC7,
-    0x0DC7,
-    0x0EC7,
-    0x0FC7,
-    0x08E7,
-    0x09E7,
-    0x0AE7,
-    0x0BE7,
-    0x0CE7,
-    0x0DE7,
-    0x0EE7,
-    0x0FE7,
-    0x1007,
-    0x1107,
-    0x1207,
-    0x1307,
-    0x1407,
-    0x1507,
-    0x1607,
-    0x1707,
-    0x1027,
-    0x1127,
-    0x1227,
-    0x1327,
-    0x1427,
-    0x1527,
-    0x1627,
-    0x1727,
-  };
-
   /* Initialise in structure order. */
 
   // Future: Table drive this copying.
 
   /* $69AE */
-  memcpy(state->movable_items, movable_items, sizeof(movable_items));
+  memcpy(state->cold.movable_items, movable_items, sizeof(movable_items));
+
+  /* $6BAD */
+  memcpy(state->cold.roomdefs.hut2_left,
+         roomdef_2_hut2_left,
+         sizeof(state->cold.roomdefs.hut2_left));
+  memcpy(state->cold.roomdefs.hut2_right,
+         roomdef_3_hut2_right,
+         sizeof(state->cold.roomdefs.hut2_right));
+  memcpy(state->cold.roomdefs.hut3_right,
+         roomdef_5_hut3_right,
+         sizeof(state->cold.roomdefs.hut3_right));
+  memcpy(state->cold.roomdefs.breakfast_23,
+         roomdef_23_breakfast,
+         sizeof(state->cold.roomdefs.breakfast_23));
+  memcpy(state->cold.roomdefs.breakfast_25,
+         roomdef_25_breakfast,
+         sizeof(state->cold.roomdefs.breakfast_25));
+  memcpy(state->cold.roomdefs.blocked_tunnel,
+         roomdef_50_blocked_tunnel,
+         sizeof(state->cold.roomdefs.blocked_tunnel));
 
   /* $7612 */
   memcpy(state->character_structs,
@@ -366,7 +354,7 @@ static void tge_initialise(tgestate_t *state)
   memcpy(state->item_structs, item_structs, sizeof(item_structs));
 
   /* $783A */
-  memcpy(state->locations, locations, sizeof(locations));
+  memcpy(state->cold.locations, locations, sizeof(locations));
 
   /* $7CFC */
   memset(&state->messages.queue[0], 0, message_queue_LENGTH);
@@ -375,13 +363,19 @@ static void tge_initialise(tgestate_t *state)
   state->messages.queue[message_queue_LENGTH - 1] = message_QUEUE_END;
   state->messages.display_index = 1 << 7; // message_NEXT
   state->messages.queue_pointer = &state->messages.queue[2];
+  render_messages(); /* Conv: Added */
 
   /* $A13C */
   state->morale = morale_MAX;
 
+  /* Conv: Scanline stride within a character row. Set before any screen
+   * addresses are worked out. */
+  state->cell_scanline_stride =
+      state->speccy->layout == zxlayout_LINEAR ? 32 : 256;
+
   /* $A141 */
-  state->moraleflag_screen_address =
-      &state->speccy->screen[0x5002 - SCREEN_START_ADDRESS];
+  state->cold.moraleflag_screen_address =
+      screen_address(state, 0x5002 - SCREEN_START_ADDRESS);
 
   /* $AD29 */
   memcpy(state->searchlight.states,
@@ -389,19 +383,82 @@ static void tge_initialise(tgestate_t *state)
          sizeof(searchlight_states));
 
   /* $EDD3 */
-  // Future: recalculate these
-  memcpy(state->game_window_start_offsets,
-         game_window_start_offsets,
-         sizeof(game_window_start_offsets));
+  state->game_window_start_offsets =
+      state->speccy->layout == zxlayout_LINEAR ?
+      &linear_game_window_start_offsets[0] :
+      &spectrum_game_window_start_offsets[0];
 
   // temporary
   memset(state->tile_buf,   0x55,  state->columns * state->rows);
   memset(state->window_buf, 0x55, (state->columns * state->rows * 8));
+  memset(state->window_buf_dirty, 0xFF, sizeof(state->window_buf_dirty));
   memset(state->map_buf,    0x55,  state->st_columns * state->st_rows);
 }
 
+static void layout(int columns, int rows, int st_columns, int st_rows, tgelayout_t *l)
+{
+  size_t offset;
+
+  offset         = ALIGN_UP(sizeof(tgestate_t));
+  l->tile_buf    = offset;
+  offset        += ALIGN_UP((size_t) (columns * rows) * sizeof(tileindex_t));
+  l->window_buf  = offset;
+  offset        += ALIGN_UP((size_t) (columns * rows * 8));
+  l->map_buf     = offset;
+  offset        += ALIGN_UP((size_t) (st_columns * st_rows) * sizeof(supertileindex_t));
+  l->total       = offset;
+
+}
+
+/* Returns p rounded up to TGE_ALIGNMENT. */
+static void *align_block(void *p)
+{
+  return (void *) ALIGN_UP((uintptr_t) p);
+}
+
+TGE_API size_t tge_footprint(const tgeconfig_t *config)
+{
+  assert(config);
+
+  (void) config; // Until we can resize...
+
+  return FOOTPRINT;
+}
+
 /**
- * Initialise the game state.
+ * Conv: Added. Choose the input device and keys as the menu would have done.
+ *
+ * \param[in] state  Pointer to game state.
+ * \param[in] config Pointer to game preferences structure.
+ */
+static void set_input(tgestate_t *state, const tgeconfig_t *config)
+{
+  keydef_t *def;
+  int       i;
+  zxkey_t   key;
+
+  assert(config->input_device >= 0);
+  assert(config->input_device < inputdevice__LIMIT);
+
+  state->chosen_input_device = (inputdevice_t) config->input_device;
+  if (state->chosen_input_device != inputdevice_KEYBOARD)
+    return;
+
+  /* zxkey_t runs through the keyboard half rows, five keys apiece, from port
+   * 0x7FFE to port 0xFEFE. */
+  def = &state->keydefs.defs[0];
+  for (i = 0; i < 5; i++)
+  {
+    key = config->keys[i];
+    assert(key >= 0 && key < zxkey__LIMIT);
+    def->port = (uint8_t) ~(0x80 >> (key / 5));
+    def->mask = (uint8_t) (1 << (key % 5));
+    def++;
+  }
+}
+
+/**
+ * Create the game state in a block of its own.
  *
  * \param[in] speccy Pointer to logical ZX Spectrum.
  * \param[in] config Pointer to game preferences structure.
@@ -409,96 +466,336 @@ static void tge_initialise(tgestate_t *state)
  */
 TGE_API tgestate_t *tge_create(zxspectrum_t *speccy, const tgeconfig_t *config)
 {
-  tgestate_t       *state                     = NULL;
-  uint16_t         *game_window_start_offsets = NULL;
-  tileindex_t      *tile_buf                  = NULL;
-  uint8_t          *window_buf                = NULL;
-  supertileindex_t *map_buf                   = NULL;
+  size_t      footprint;
+  void       *heap;
+  tgestate_t *state;
 
   assert(config);
 
   if (!config)
-    goto failure;
-  
-  /* Allocate state structure. */
+    return NULL;
+
+  footprint = tge_footprint(config);
+
+#ifdef TGE_NO_HEAP
+  if (static_block_in_use || footprint > FOOTPRINT)
+    return NULL;
+  heap = static_block;
+#else
+  heap = malloc(footprint + TGE_ALIGNMENT - 1);
+  if (heap == NULL)
+    return NULL;
+#endif
 
-  state = calloc(1, sizeof(*state));
+  state = tge_create_in(speccy, config, align_block(heap), footprint);
   if (state == NULL)
-    goto failure;
+  {
+#ifndef TGE_NO_HEAP
+    free(heap);
+#endif
+    return NULL;
+  }
+
+#ifdef TGE_NO_HEAP
+  static_block_in_use = 1;
+#endif
+  state->cold.heap = heap;
+
+  return state;
+}
+
+/**
+ * Initialise the game state in caller-supplied memory.
+ *
+ * \param[in] speccy Pointer to logical ZX Spectrum.
+ * \param[in] config Pointer to game preferences structure.
+ * \param[in] block  Memory aligned to TGE_ALIGNMENT.
+ * \param[in] size   Size of block in bytes.
+ * \return Pointer to game state (at block).
+ */
+TGE_API tgestate_t *tge_create_in(zxspectrum_t      *speccy,
+                                  const tgeconfig_t *config,
+                                  void              *block,
+                                  size_t             size)
+{
+  unsigned char *base = block;
+  tgestate_t    *state;
+  tgelayout_t    l;
+
+  assert(config);
+  assert(block);
+  assert(((uintptr_t) block & (TGE_ALIGNMENT - 1)) == 0);
+
+  if (!config || !block)
+    return NULL;
+
+  layout(COLUMNS, ROWS, ST_COLUMNS, ST_ROWS, &l);
+  assert(l.total == FOOTPRINT);
+  if (size < l.total)
+    return NULL;
+
+  memset(block, 0, l.total);
+
+  state = (tgestate_t *) base;
   
   /* Configure. */
   
-  state->width      = config->width;
-  state->height     = config->height;
+  state->cold.width  = config->width;
+  state->cold.height = config->height;
+
+  state->cold.skip_transitions = config->skip_transitions;
+  state->cold.skip_menu        = config->skip_menu;
+
+  state->render_interval  = 1;
+  state->render_countdown = 0;
+  state->render_requested = 0;
+  state->rendering        = 1;
+  state->window_stale     = 0;
 
   // Until we can resize...
-  assert(state->width  == 32);
-  assert(state->height == 24);
-
-  /* Set the size of the window buffer. The game screen is assumed to be one smaller in both
-   * dimensions. That is a 24x17 buffer is displayed through a 23x16 window on-screen. This allows
-   * for rolling/scrolling. */
-  state->columns    = 24;
-  state->rows       = 17;
-
-  /* This is held separately, rather than computed from columns and rows, as
-   * it's wider than I expected it to be. */
-  state->st_columns = 7;
-  state->st_rows    = 5;
-  
-  /* Allocate buffers. */
+  assert(state->cold.width  == 32);
+  assert(state->cold.height == 24);
+
+  state->columns    = COLUMNS;
+  state->rows       = ROWS;
+
+  assert(state->columns <= 32);
+  assert(state->rows    <= WINDOW_BUF_MAX_ROWS);
+
+  state->st_columns = ST_COLUMNS;
+  state->st_rows    = ST_ROWS;
+
+  /* Use the renderer specialised for the standard size where possible. */
+  if (state->columns    == 24 && state->rows    == 17 &&
+      state->st_columns == 7  && state->st_rows == 5)
+    state->renderer = &renderer_24x17;
+  else
+    state->renderer = &renderer_generic;
   
-  game_window_start_offsets = calloc(1, (size_t) ((state->rows - 1) * 8) * sizeof(*game_window_start_offsets));
-  tile_buf                  = calloc(1, (size_t) (state->columns * state->rows));
-  window_buf                = calloc(1, (size_t) (state->columns * state->rows * 8));
-  map_buf                   = calloc(1, (size_t) (state->st_columns * state->st_rows));
-
-  if (game_window_start_offsets == NULL ||
-      tile_buf                  == NULL ||
-      window_buf                == NULL ||
-      map_buf                   == NULL)
-    goto failure;
+  /* Lay out buffers. */
   
-  state->game_window_start_offsets = game_window_start_offsets;
-  state->tile_buf                  = tile_buf;
-  state->window_buf                = window_buf;
-  state->map_buf                   = map_buf;
+  state->tile_buf   = (tileindex_t *)      (base + l.tile_buf);
+  state->window_buf = (uint8_t *)          (base + l.window_buf);
+  state->map_buf    = (supertileindex_t *) (base + l.map_buf);
   
-  state->prng_index                = 0;
+  state->prng_index = 0;
 
   /* Initialise additional variables. */
   
   state->speccy = speccy;
+  state->cold.heap = NULL;
   
   /* Initialise original game variables. */
   
   tge_initialise(state);
 
+  if (state->cold.skip_menu)
+    set_input(state, config);
+
   return state;
+}
 
+TGE_API void tge_destroy(tgestate_t *state)
+{
+  void *heap;
 
-failure:
+  if (state == NULL)
+    return;
 
-  free(game_window_start_offsets);
-  free(map_buf);
-  free(window_buf);
-  free(tile_buf);
-  free(state);
-  
-  return NULL;
+  heap = state->cold.heap;
+#ifdef TGE_NO_HEAP
+  if (heap)
+    static_block_in_use = 0;
+#else
+  free(heap);
+#endif
 }
 
-TGE_API void tge_destroy(tgestate_t *state)
+/**
+ * Conv: Added. Capture the template used by tge_reset, unless another
+ * instance got there first. Called once tge_setup is done.
+ *
+ * \param[in] state Pointer to game state.
+ */
+void capture_template(tgestate_t *state)
 {
-  if (state == NULL)
+  assert(state != NULL);
+
+  if (!COMPARE_AND_SWAP(&template.status, template_EMPTY, template_CAPTURING))
     return;
 
-  free(state->game_window_start_offsets);
-  free(state->map_buf);
-  free(state->window_buf);
-  free(state->tile_buf);
+  template.base   = (uintptr_t) state;
+  template.screen = (uintptr_t) &state->speccy->screen[0];
+  template.layout = state->speccy->layout;
+  memcpy(template.block, state, FOOTPRINT);
+  /* The attributes follow the screen directly. */
+  memcpy(template.screen_data, &state->speccy->screen[0], sizeof(template.screen_data));
+
+  (void) COMPARE_AND_SWAP(&template.status, template_CAPTURING, template_READY);
+}
+
+/**
+ * Move a pointer copied from the template to the corresponding place in the
+ * given instance. Pointers to constant data are left alone.
+ */
+static void *rebase(const void *p, tgestate_t *state)
+{
+  uintptr_t q = (uintptr_t) p;
+
+  if (q - template.base < FOOTPRINT)
+    return (unsigned char *) state + (q - template.base);
+  if (q - template.screen < sizeof(template.screen_data))
+    return &state->speccy->screen[0] + (q - template.screen);
+  return (void *) p;
+}
+
+#define REBASE(field) state->field = rebase(state->field, state)
 
-  free(state);
+TGE_API void tge_reset(tgestate_t *state)
+{
+  zxspectrum_t *speccy;
+  void         *heap;
+  int           skip_transitions;
+  int           skip_menu;
+  int           render_interval;
+  keydefs_t     keydefs;
+  inputdevice_t input_device;
+  tgeconfig_t   config;
+
+  assert(state != NULL);
+
+  speccy           = state->speccy;
+  heap             = state->cold.heap;
+  skip_transitions = state->cold.skip_transitions;
+  skip_menu        = state->cold.skip_menu;
+  render_interval  = state->render_interval;
+  keydefs          = state->keydefs;
+  input_device     = state->chosen_input_device;
+
+  if (LOAD_ACQUIRE(&template.status) == template_READY &&
+      template.layout == speccy->layout)
+  {
+    memcpy(state, template.block, FOOTPRINT);
+    memcpy(&speccy->screen[0], template.screen_data, sizeof(template.screen_data));
+
+    state->speccy = speccy;
+
+    REBASE(IY);
+    REBASE(messages.queue_pointer);
+    REBASE(messages.current_character);
+    REBASE(window_buf_pointer);
+    REBASE(bitmap_pointer);
+    REBASE(mask_pointer);
+    REBASE(foreground_mask_pointer);
+    REBASE(cold.moraleflag_screen_address);
+    REBASE(cold.ptr_to_door_being_lockpicked);
+    REBASE(tile_buf);
+    REBASE(window_buf);
+    REBASE(map_buf);
+  }
+  else
+  {
+    /* No usable template: start afresh, as tge_create and tge_setup would.
+     * This captures a template if there's none yet. */
+    memset(&config, 0, sizeof(config));
+    config.width            = state->cold.width;
+    config.height           = state->cold.height;
+    config.skip_transitions = skip_transitions;
+    config.skip_menu        = skip_menu;
+    config.input_device     = input_device; /* keys are restored below */
+    (void) tge_create_in(speccy, &config, state, FOOTPRINT);
+    tge_setup(state);
+  }
+
+  /* Keep this instance's own settings. */
+  state->cold.heap                = heap;
+  state->cold.skip_transitions    = skip_transitions;
+  state->cold.skip_menu           = skip_menu;
+  state->keydefs                  = keydefs;
+  state->chosen_input_device      = input_device;
+  tge_set_render_interval(state, render_interval);
+
+  if (state->zoombox.opening && skip_transitions)
+    zoombox_open(state);
+}
+
+#undef REBASE
+
+/**
+ * Where a pointer in an instance points: an offset into its block or its
+ * screen, or the pointer itself when it points at constant data.
+ */
+static uintptr_t unbase(const void *p, const tgestate_t *state)
+{
+  uintptr_t q      = (uintptr_t) p;
+  uintptr_t base   = (uintptr_t) state;
+  uintptr_t screen = (uintptr_t) &state->speccy->screen[0];
+
+  if (q - base < FOOTPRINT)
+    return q - base;
+  if (q - screen < sizeof(template.screen_data))
+    return FOOTPRINT + (q - screen);
+  return q;
+}
+
+/**
+ * Copy an instance's state, leaving out what only rendering uses, and with
+ * the pointers which tge_reset rebases made independent of where the
+ * instance is.
+ */
+static void game_state(const tgestate_t *state, tgestate_t *copy)
+{
+  memcpy(copy, state, sizeof(*copy));
+
+#define UNBASE(field) copy->field = (void *) unbase(state->field, state)
+  UNBASE(IY);
+  UNBASE(messages.queue_pointer);
+  UNBASE(cold.moraleflag_screen_address);
+  UNBASE(cold.ptr_to_door_being_lockpicked);
+#undef UNBASE
+
+  /* Render bookkeeping. */
+  copy->render_interval  = 0;
+  copy->render_countdown = 0;
+  copy->render_requested = 0;
+  copy->rendering        = 0;
+  copy->window_stale     = 0;
+  memset(&copy->window_buf_dirty, 0, sizeof(copy->window_buf_dirty));
+  memset(&copy->window_buf_plotted_offset, 0, sizeof(copy->window_buf_plotted_offset));
+
+  /* Left behind by the plotters, which skipped frames don't run. The game
+   * reads the mask buffer only once it has built the hero's mask afresh. */
+  memset(&copy->mask_buffer, 0, sizeof(copy->mask_buffer));
+  copy->window_buf_pointer      = NULL;
+  copy->foreground_mask_pointer = NULL;
+
+  /* The instance's own. */
+  memset(&copy->jmpbuf_main, 0, sizeof(copy->jmpbuf_main));
+  copy->speccy     = NULL;
+  copy->tile_buf   = NULL;
+  copy->window_buf = NULL;
+  copy->map_buf    = NULL;
+  copy->cold.heap  = NULL;
+}
+
+TGE_API int tge_compare(const tgestate_t *a, const tgestate_t *b)
+{
+  tgestate_t game_a;
+  tgestate_t game_b;
+
+  assert(a != NULL);
+  assert(b != NULL);
+
+  game_state(a, &game_a);
+  game_state(b, &game_b);
+  if (memcmp(&game_a, &game_b, sizeof(game_a)) != 0)
+    return 1;
+
+  /* The supertile map is kept up to date on every frame. The tile and
+   * window buffers are not. */
+  return memcmp(a->map_buf,
+                b->map_buf,
+                (size_t) (a->st_columns * a->st_rows) * sizeof(*a->map_buf)) != 0;
 }
 
 // vim: ts=8 sts=2 sw=2 et
@@ -121,8 +121,15 @@ const tile_t mask_tiles[111] =
   { { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE } },
 };
 
-const tile_t exterior_tiles_1[145] =
+/**
+ * $8590: Exterior tiles, in three sets.
+ *
+ * Conv: The sets are one array so they stay contiguous, as in the original.
+ * Supertiles index past the end of their own set into the next.
+ */
+const tile_t exterior_tiles[exterior_tiles__LIMIT] =
 {
+  /* $8590: Set 1. */
   { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
   { { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 } },
   { { 0xFF, 0xF0, 0x00, 0x8C, 0xC3, 0xB0, 0x80, 0xC0 } },
@@ -268,10 +275,8 @@ const tile_t exterior_tiles_1[145] =
   { { 0x00, 0xC0, 0xF0, 0xFC, 0x3E, 0x0F, 0xC2, 0xF1 } },
   { { 0xFB, 0x37, 0x0F, 0x1C, 0x30, 0x00, 0x00, 0x40 } },
   { { 0xC0, 0xC4, 0x00, 0x00, 0x20, 0x18, 0x00, 0x00 } },
-};
 
-const tile_t exterior_tiles_2[220] =
-{
+  /* $8A18: Set 2. */
   { { 0x00, 0x01, 0x00, 0x30, 0x00, 0x02, 0x00, 0x00 } },
   { { 0x04, 0x00, 0x00, 0x00, 0x80, 0x00, 0x18, 0x04 } },
   { { 0x02, 0x80, 0x00, 0x08, 0x04, 0x00, 0x60, 0x00 } },
@@ -492,10 +497,8 @@ const tile_t exterior_tiles_2[220] =
   { { 0x23, 0xCF, 0x33, 0x4C, 0x53, 0x5C, 0x2F, 0x23 } },
   { { 0xD3, 0xD0, 0xB0, 0xB0, 0xB3, 0xB7, 0xB3, 0xCC } },
   { { 0xD3, 0xD4, 0xB6, 0xB7, 0xB7, 0xB4, 0xF0, 0xEC } },
-};
 
-const tile_t exterior_tiles_3[206] =
-{
+  /* $90F8: Set 3. */
   { { 0x4C, 0x32, 0xC0, 0x20, 0x04, 0x03, 0x0C, 0x32 } },
   { { 0x18, 0x3C, 0x78, 0xB4, 0xE0, 0xCC, 0xA3, 0x44 } },
   { { 0x40, 0x08, 0x08, 0x00, 0x00, 0x00, 0x20, 0xC0 } },
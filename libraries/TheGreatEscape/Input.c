@@ -26,7 +26,7 @@ static input_t inputroutine_keyboard(tgestate_t *state)
 
   /* Left or right? */
   port = (def->port << 8) | 0xFE;
-  key_pressed = ~state->speccy->in(state->speccy, port) & def->mask;
+  key_pressed = ~zxinput_read(&state->speccy->input, port) & def->mask;
   def++;
   if (key_pressed)
   {
@@ -37,7 +37,7 @@ static input_t inputroutine_keyboard(tgestate_t *state)
   {
     /* Right */
     port = (def->port << 8) | 0xFE;
-    key_pressed = ~state->speccy->in(state->speccy, port) & def->mask;
+    key_pressed = ~zxinput_read(&state->speccy->input, port) & def->mask;
     def++;
     if (key_pressed)
       inputs = input_RIGHT;
@@ -47,7 +47,7 @@ static input_t inputroutine_keyboard(tgestate_t *state)
 
   /* Up or down? */
   port = (def->port << 8) | 0xFE;
-  key_pressed = ~state->speccy->in(state->speccy, port) & def->mask;
+  key_pressed = ~zxinput_read(&state->speccy->input, port) & def->mask;
   def++;
   if (key_pressed)
   {
@@ -58,7 +58,7 @@ static input_t inputroutine_keyboard(tgestate_t *state)
   {
     /* Down */
     port = (def->port << 8) | 0xFE;
-    key_pressed = ~state->speccy->in(state->speccy, port) & def->mask;
+    key_pressed = ~zxinput_read(&state->speccy->input, port) & def->mask;
     def++;
     if (key_pressed)
       inputs += input_DOWN;
@@ -66,7 +66,7 @@ static input_t inputroutine_keyboard(tgestate_t *state)
 
   /* Fire? */
   port = (def->port << 8) | 0xFE;
-  key_pressed = ~state->speccy->in(state->speccy, port) & def->mask;
+  key_pressed = ~zxinput_read(&state->speccy->input, port) & def->mask;
   if (key_pressed)
     inputs += input_FIRE;
 
@@ -95,19 +95,19 @@ static input_t inputroutine_protek(tgestate_t *state)
   assert(state != NULL);
 
   /* Horizontal */
-  keybits_left = ~state->speccy->in(state->speccy, port_KEYBOARD_12345);
+  keybits_left = ~zxinput_read(&state->speccy->input, port_KEYBOARD_12345);
   left_right = input_LEFT;
   port = port_KEYBOARD_09876;
   if ((keybits_left & (1 << 4)) == 0)
   {
-    keybits_left = ~state->speccy->in(state->speccy, port);
+    keybits_left = ~zxinput_read(&state->speccy->input, port);
     left_right = input_RIGHT;
     if ((keybits_left & (1 << 2)) == 0)
       left_right = 0;
   }
 
   /* Vertical */
-  keybits_others = ~state->speccy->in(state->speccy, port);
+  keybits_others = ~zxinput_read(&state->speccy->input, port);
   up_down = input_UP;
   if ((keybits_others & (1 << 3)) == 0)
   {
@@ -145,7 +145,7 @@ static input_t inputroutine_kempston(tgestate_t *state)
 
   assert(state != NULL);
 
-  keybits = state->speccy->in(state->speccy, 0x001F);
+  keybits = zxinput_read(&state->speccy->input, port_KEMPSTON_JOYSTICK);
 
   left_right = up_down = 0;
 
@@ -194,7 +194,7 @@ static input_t inputroutine_fuller(tgestate_t *state)
 
   assert(state != NULL);
 
-  keybits = state->speccy->in(state->speccy, 0x007F);
+  keybits = zxinput_read(&state->speccy->input, port_FULLER_JOYSTICK);
 
   left_right = up_down = 0;
 
@@ -244,7 +244,7 @@ static input_t inputroutine_sinclair(tgestate_t *state)
 
   assert(state != NULL);
 
-  keybits = ~state->speccy->in(state->speccy, port_KEYBOARD_09876); /* xxx67890 */
+  keybits = ~zxinput_read(&state->speccy->input, port_KEYBOARD_09876); /* xxx67890 */
 
   left_right = up_down = 0;
 
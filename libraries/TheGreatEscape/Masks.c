@@ -464,6 +464,48 @@ const uint8_t *mask_pointers[30] =
   &interior_mask_26[0]  /* $EA4A */
 };
 
+/**
+ * Lengths of the run-length encoded mask data, in the same order as
+ * mask_pointers.
+ *
+ * Conv: Added. Some masks' bounds exceed their data and the original simply
+ * read on into whatever followed.
+ */
+const uint16_t mask_lengths[30] =
+{
+  sizeof(exterior_mask_0),  /* $E55F */
+  sizeof(exterior_mask_1),  /* $E5FF */
+  sizeof(exterior_mask_2),  /* $E61E */
+  sizeof(exterior_mask_3),  /* $E6CA */
+  sizeof(exterior_mask_4),  /* $E74B */
+  sizeof(exterior_mask_5),  /* $E758 */
+  sizeof(exterior_mask_6),  /* $E77F */
+  sizeof(exterior_mask_7),  /* $E796 */
+  sizeof(exterior_mask_8),  /* $E7AF */
+  sizeof(exterior_mask_9),  /* $E85C */
+  sizeof(exterior_mask_10), /* $E8A3 */
+  sizeof(exterior_mask_11), /* $E8F0 */
+  sizeof(exterior_mask_13), /* $E940 */
+  sizeof(exterior_mask_14), /* $E972 */
+  sizeof(exterior_mask_12), /* $E92F */
+
+  sizeof(interior_mask_29), /* $EA67 */
+  sizeof(interior_mask_27), /* $EA53 */
+  sizeof(interior_mask_28), /* $EA5D */
+  sizeof(interior_mask_15), /* $E99A */
+  sizeof(interior_mask_16), /* $E99F */
+  sizeof(interior_mask_17), /* $E9B9 */
+  sizeof(interior_mask_18), /* $E9C6 */
+  sizeof(interior_mask_19), /* $E9CB */
+  sizeof(interior_mask_20), /* $E9E6 */
+  sizeof(interior_mask_21), /* $E9F5 */
+  sizeof(interior_mask_22), /* $EA0E */
+  sizeof(interior_mask_23), /* $EA2B */
+  sizeof(interior_mask_24), /* $EA35 */
+  sizeof(interior_mask_25), /* $EA43 */
+  sizeof(interior_mask_26)  /* $EA4A */
+};
+
 /**
  * $EC01: mask_t structs for the exterior scene.
  */
@@ -17,6 +17,10 @@ static void choose_keys(tgestate_t *state);
 
 static uint8_t menu_keyscan(tgestate_t *state);
 
+static void play_music_frame(tgestate_t *state,
+                             uint16_t    tuning0,
+                             uint16_t    tuning1);
+
 /**
  * $F271: Menu screen key handling.
  *
@@ -99,6 +103,8 @@ static void wipe_game_window(tgestate_t *state)
     memset(p, 0, state->columns - 1); /* 23 columns (not 24 like the back buffer) */
   }
   while (--iters);
+
+  invalidate_game_window(state);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -175,8 +181,6 @@ static void choose_keys(tgestate_t *state)
   assert(state != NULL);
   assert(state->speccy != NULL);
 
-  uint8_t *const screen = &state->speccy->screen[0]; /* Conv: Added */
-
   /* Loop while the user does not confirm. */
   for (;;)
   {
@@ -196,14 +200,14 @@ static void choose_keys(tgestate_t *state)
       uint8_t     iters;     /* was B */
       const char *string;    /* was HL */
 
-      screenptr = &state->speccy->screen[prompt->screenloc];
+      screenptr = screen_address(state, prompt->screenloc);
       iters  = prompt->length;
       string = prompt->string;
       do
       {
         // A = *HLstring; /* Conv: Present in original code but this is redundant when calling plot_glyph(). */
         ASSERT_SCREEN_PTR_VALID(screenptr);
-        screenptr = plot_glyph(string, screenptr);
+        screenptr = plot_glyph(state, string, screenptr);
         string++;
       }
       while (--iters);
@@ -248,7 +252,8 @@ static void choose_keys(tgestate_t *state)
 for_loop:
           for (;;)
           {
-            state->speccy->sleep(state->speccy, sleeptype_MENU, 10000); // 10000 is arbitrary for the moment
+            /* Conv: Waiting for a key, so the frontend may end this early. */
+            state->speccy->sleep(state->speccy, sleeptype_KEYSCAN, 10000); // 10000 is arbitrary for the moment
 
             SWAP(uint8_t, A, Adash);
 
@@ -262,7 +267,7 @@ try_next_port:
               goto for_loop;
 
             port = A; // saved so it can be stored later
-            A = ~state->speccy->in(state->speccy, (port << 8) | 0xFE);
+            A = ~zxinput_read(&state->speccy->input, (port << 8) | 0xFE);
             keyflags = A;
             mask = 1 << 5;
 key_loop:
@@ -336,12 +341,12 @@ assign_keydef:
           }
 
           /* Plot. */
-          screenptr = screen + screenoff; // self modified // screen offset
+          screenptr = screen_address(state, screenoff); // self modified // screen offset
           do
           {
             // glyph_and_flags = *pkeyname; // Conv: dead code? similar to other instances of calls to plot_glyph
             ASSERT_SCREEN_PTR_VALID(screenptr);
-            screenptr = plot_glyph(pkeyname, screenptr);
+            screenptr = plot_glyph(state, pkeyname, screenptr);
             pkeyname++;
           }
           while (--length);
@@ -384,7 +389,7 @@ void set_menu_item_attributes(tgestate_t *state,
   pattr = &state->speccy->attributes[(0x590D - SCREEN_ATTRIBUTES_START_ADDRESS)];
 
   /* Skip to the item's row */
-  pattr += index * 2 * state->width; /* two rows */
+  pattr += index * 2 * state->cold.width; /* two rows */
 
   /* Draw */
   ASSERT_SCREEN_ATTRIBUTES_PTR_VALID(pattr);
@@ -411,7 +416,7 @@ static uint8_t menu_keyscan(tgestate_t *state)
 
   count = 0;
   /* Keys 1..4 only. */
-  keymask = ~state->speccy->in(state->speccy, port_KEYBOARD_12345) & 0xF;
+  keymask = ~zxinput_read(&state->speccy->input, port_KEYBOARD_12345) & 0xF;
   if (keymask)
   {
     iters = 4;
@@ -430,7 +435,7 @@ static uint8_t menu_keyscan(tgestate_t *state)
   else
   {
     /* Key 0 only. */
-    if ((state->speccy->in(state->speccy, port_KEYBOARD_09876) & 1) == 0)
+    if ((zxinput_read(&state->speccy->input, port_KEYBOARD_09876) & 1) == 0)
       return count; /* always zero */
 
     return 0xFF; /* no keypress */
@@ -439,6 +444,115 @@ static uint8_t menu_keyscan(tgestate_t *state)
 
 /* ----------------------------------------------------------------------- */
 
+/**
+ * Inner iterations of the original tune loop per menu frame (255 * 24).
+ */
+#define MUSIC_FRAME_ITERATIONS (255 * 24)
+
+/**
+ * T-states per inner iteration of the original tune loop. 6120 iterations at
+ * this rate fill the 87.5ms menu frame.
+ */
+#define MUSIC_ITERATION_TSTATES 50
+
+/**
+ * Returns the number of tune loop iterations between speaker toggles for a
+ * counter pair returned by get_tuning().
+ *
+ * The original decrements the low byte on every iteration and the high byte
+ * each time the low byte reaches zero, toggling when both have run out.
+ *
+ * \param[in] tuning Counter pair from get_tuning().
+ *
+ * \return Half period in iterations.
+ */
+static unsigned int tuning_to_period(uint16_t tuning)
+{
+  unsigned int lo, hi;
+
+  lo = tuning & 0xFF;
+  hi = tuning >> 8;
+  if (lo == 0)
+    lo = 256;
+  if (hi == 0)
+    hi = 256;
+
+  return lo + 256 * (hi - 1);
+}
+
+/**
+ * Plays one menu frame's worth of both tune channels.
+ *
+ * Conv: Replaces the original's 255 * 24 iteration busy loop. Rather than
+ * step every iteration this works out when each channel's counter next runs
+ * out and jumps straight there, emitting the speaker edge then advancing the
+ * virtual clock with non-blocking sound delays. The cost is proportional to
+ * the number of edges, not to the time played. As in the original both
+ * channels share the speaker (the last one to toggle wins) and the counters
+ * and speaker levels restart every frame.
+ *
+ * \param[in] state   Pointer to game state.
+ * \param[in] tuning0 Channel 0 counter pair from get_tuning(). (was BC/DE)
+ * \param[in] tuning1 Channel 1 counter pair from get_tuning(). (was BC'/DE')
+ */
+static void play_music_frame(tgestate_t *state,
+                             uint16_t    tuning0,
+                             uint16_t    tuning1)
+{
+  unsigned int period0, period1; /* iterations between toggles */
+  unsigned int next0, next1;     /* iteration of next toggle */
+  uint8_t      level0, level1;   /* speaker bit per channel (was L, L') */
+  unsigned int now;              /* iteration reached */
+  unsigned int elapsed;          /* sound delay units issued so far */
+  unsigned int target;           /* sound delay units wanted */
+
+  assert(state != NULL);
+
+  period0 = tuning_to_period(tuning0);
+  period1 = tuning_to_period(tuning1);
+  next0   = period0;
+  next1   = period1;
+  level0  = 0;
+  level1  = 0;
+  elapsed = 0;
+
+  for (;;)
+  {
+    now = (next0 < next1) ? next0 : next1;
+    if (now > MUSIC_FRAME_ITERATIONS)
+      break;
+
+    /* Sound delays advance the clock in units of 16 T-states. */
+    target = now * MUSIC_ITERATION_TSTATES / 16;
+    if (target > elapsed)
+    {
+      state->speccy->sleep(state->speccy, sleeptype_SOUND, target - elapsed);
+      elapsed = target;
+    }
+
+    /* Channel 0 is serviced first within an iteration. */
+    if (next0 == now)
+    {
+      level0 ^= 16;
+      state->speccy->out(state->speccy, port_BORDER, level0);
+      next0 += period0;
+    }
+    if (next1 == now)
+    {
+      level1 ^= 16;
+      state->speccy->out(state->speccy, port_BORDER, level1);
+      next1 += period1;
+    }
+  }
+
+  /* Run out the rest of the frame. */
+  target = MUSIC_FRAME_ITERATIONS * MUSIC_ITERATION_TSTATES / 16;
+  if (target > elapsed)
+    state->speccy->sleep(state->speccy, sleeptype_SOUND, target - elapsed);
+}
+
+/* ----------------------------------------------------------------------- */
+
 /**
  * $F4B7: Runs the menu screen.
  *
@@ -449,21 +563,11 @@ static uint8_t menu_keyscan(tgestate_t *state)
  */
 void menu_screen(tgestate_t *state)
 {
-  uint16_t BC;              /* was BC */
-  uint16_t BCdash;          /* was BC' */
-  uint16_t DE;              /* was DE */
-  uint16_t DEdash;          /* was DE' */
-  uint8_t  datum;           /* was A */
-  uint8_t  overall_delay;   /* was A */
-  uint8_t  iters;           /* was H */
-  uint16_t channel0_index;  /* was HL */
-  uint16_t channel1_index;  /* was HL' */
-  uint8_t  L;               /* was L */
-  uint8_t  Ldash;           /* was L' */
-  uint8_t  B;               /* was B */
-  uint8_t  C;               /* was C */
-  uint8_t  Bdash;           /* was B' */
-  uint8_t  Cdash;           /* was C' */
+  uint16_t tuning0;        /* was BC/DE */
+  uint16_t tuning1;        /* was BC'/DE' */
+  uint8_t  datum;          /* was A */
+  uint16_t channel0_index; /* was HL */
+  uint16_t channel1_index; /* was HL' */
 
   assert(state != NULL);
 
@@ -476,70 +580,37 @@ void menu_screen(tgestate_t *state)
     wave_morale_flag(state);
 
     /* Play music */
-    channel0_index = state->music_channel0_index + 1;
+    channel0_index = state->cold.music_channel0_index + 1;
     /* Loop until the end marker is encountered. */
     for (;;)
     {
-      state->music_channel0_index = channel0_index;
+      state->cold.music_channel0_index = channel0_index;
       datum = music_channel0_data[channel0_index];
       if (datum != 0xFF) /* end marker */
         break;
       channel0_index = 0;
     }
-    DE = BC = get_tuning(datum);
-    channel0_index &= 0xFF00; // was L = 0;
+    tuning0 = get_tuning(datum);
 
-    channel1_index = state->music_channel1_index + 1;
+    channel1_index = state->cold.music_channel1_index + 1;
     /* Loop until the end marker is encountered. */
     for (;;)
     {
-      state->music_channel1_index = channel1_index;
+      state->cold.music_channel1_index = channel1_index;
       datum = music_channel1_data[channel1_index];
       if (datum != 0xFF) /* end marker */
         break;
       channel1_index = 0;
     }
-    DEdash = BCdash = get_tuning(datum);
-    channel1_index &= 0xFF00; // was Ldash = 0;
+    tuning1 = get_tuning(datum);
 
-    if ((BCdash >> 8) == 0xFF) // (BCdash >> 8) was Bdash;
-    {
-      BCdash = BC;
-      DEdash = BCdash;
-    }
-
-    overall_delay = 24; /* overall tune speed (a delay: lower values are faster) */
-    do
-    {
-      iters = 255;
-      do
-      {
-        // B,C are a pair of counters?
+    /* A silent channel 1 doubles channel 0. */
+    if ((tuning1 >> 8) == 0xFF) // (tuning1 >> 8) was B'
+      tuning1 = tuning0;
 
-        B = BC >> 8;
-        C = BC & 0xFF;
-        if (--B == 0 && --C == 0)
-        {
-          channel0_index ^= 16;
-          state->speccy->out(state->speccy, port_BORDER, channel0_index & 0xFF);
-          BC = DE;
-        }
-        // FIXME else B & C need writing back
+    /* overall tune speed was a delay of 24 * 255 iterations */
+    play_music_frame(state, tuning0, tuning1);
 
-        Bdash = BCdash >> 8;
-        Cdash = BCdash & 0xFF;
-        if (--Bdash == 0 && --Cdash == 0)
-        {
-          channel1_index ^= 16;
-          state->speccy->out(state->speccy, port_BORDER, channel1_index & 0xFF);
-          BCdash = DEdash;
-        }
-        // FIXME else B' & C' need writing back
-      }
-      while (--iters);
-    }
-    while (--overall_delay);
-    
     state->speccy->kick(state->speccy);
     state->speccy->sleep(state->speccy, sleeptype_MENU, 87500);
   }
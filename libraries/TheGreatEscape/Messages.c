@@ -5,6 +5,7 @@
 #include "TheGreatEscape/Messages.h"
 #include "TheGreatEscape/State.h"
 #include "TheGreatEscape/Text.h"
+#include "TheGreatEscape/Utils.h"
 
 /* ----------------------------------------------------------------------- */
 
@@ -17,6 +18,84 @@ static void next_message(tgestate_t *state);
 
 #define message_NEXT (1 << 7)
 
+/**
+ * $7DCD: Game messages.
+ *
+ * Conv: These are 0xFF terminated in the original game.
+ */
+static const char *const messages_table[message__LIMIT] =
+{
+  "MISSED ROLL CALL",
+  "TIME TO WAKE UP",
+  "BREAKFAST TIME",
+  "EXERCISE TIME",
+  "TIME FOR BED",
+  "THE DOOR IS LOCKED",
+  "IT IS OPEN",
+  "INCORRECT KEY",
+  "ROLL CALL",
+  "RED CROSS PARCEL",
+  "PICKING THE LOCK",
+  "CUTTING THE WIRE",
+  "YOU OPEN THE BOX",
+  "YOU ARE IN SOLITARY",
+  "WAIT FOR RELEASE",
+  "MORALE IS ZERO",
+  "ITEM DISCOVERED",
+
+  "HE TAKES THE BRIBE", /* $F026 */
+  "AND ACTS AS DECOY",  /* $F039 */
+  "ANOTHER DAY DAWNS"   /* $F04B */
+};
+
+/* ----------------------------------------------------------------------- */
+
+enum
+{
+  strips_EMPTY,
+  strips_RENDERING,
+  strips_READY
+};
+
+/**
+ * Conv: Added. Every message pre-rendered, so revealing a character is a
+ * copy rather than a walk through the font. Shared by all instances and
+ * immutable once ready.
+ */
+static struct
+{
+  volatile long status; /* strips_* */
+  textstrip_t   strips[message__LIMIT];
+}
+message_strips;
+
+/**
+ * Conv: Pre-render every message into message_strips, unless that's done.
+ * The first caller renders them; any others racing it wait until it's done.
+ */
+void render_messages(void)
+{
+  int message;
+
+  if (LOAD_ACQUIRE(&message_strips.status) == strips_READY)
+    return;
+
+  if (!COMPARE_AND_SWAP(&message_strips.status, strips_EMPTY, strips_RENDERING))
+  {
+    /* Another instance is rendering them. It takes microseconds. */
+    while (LOAD_ACQUIRE(&message_strips.status) != strips_READY)
+      ;
+    return;
+  }
+
+  for (message = 0; message < message__LIMIT; message++)
+    render_text_strip(messages_table[message],
+                      (int) strlen(messages_table[message]),
+                      &message_strips.strips[message]);
+
+  (void) COMPARE_AND_SWAP(&message_strips.status, strips_RENDERING, strips_READY);
+}
+
 /* ----------------------------------------------------------------------- */
 
 /**
@@ -85,8 +164,9 @@ void message_display(tgestate_t *state)
   else
   {
     pmsgchr = state->messages.current_character;
-    pscr    = &state->speccy->screen[screen_text_start_address + index];
-    (void) plot_glyph(pmsgchr, pscr);
+    pscr    = screen_address(state, screen_text_start_address + index);
+    /* Conv: Copy the character from the pre-rendered message. */
+    (void) plot_text_strip(state, state->messages.current_strip, index, 1, pscr);
 
     state->messages.display_index = index + 1; // Conv: Original used (pscr & 31). CHECK
 
@@ -127,10 +207,11 @@ void wipe_message(tgestate_t *state)
   index -= message_NEXT;
   assert(index < 128);
 
-  scr = &state->speccy->screen[screen_text_start_address + index];
+  scr = screen_address(state, screen_text_start_address + index);
 
-  /* Plot a single space character. */
-  (void) plot_single_glyph(' ', scr);
+  /* Plot a single space character.
+   * Conv: The space glyph is blank so just wipe. */
+  screen_wipe(state, 1, 8, scr);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -144,36 +225,6 @@ void wipe_message(tgestate_t *state)
  */
 void next_message(tgestate_t *state)
 {
-  /**
-   * $7DCD: Game messages.
-   *
-   * Conv: These are 0xFF terminated in the original game.
-   */
-  static const char *messages_table[message__LIMIT] =
-  {
-    "MISSED ROLL CALL",
-    "TIME TO WAKE UP",
-    "BREAKFAST TIME",
-    "EXERCISE TIME",
-    "TIME FOR BED",
-    "THE DOOR IS LOCKED",
-    "IT IS OPEN",
-    "INCORRECT KEY",
-    "ROLL CALL",
-    "RED CROSS PARCEL",
-    "PICKING THE LOCK",
-    "CUTTING THE WIRE",
-    "YOU OPEN THE BOX",
-    "YOU ARE IN SOLITARY",
-    "WAIT FOR RELEASE",
-    "MORALE IS ZERO",
-    "ITEM DISCOVERED",
-
-    "HE TAKES THE BRIBE", /* $F026 */
-    "AND ACTS AS DECOY",  /* $F039 */
-    "ANOTHER DAY DAWNS"   /* $F04B */
-  };
-
   uint8_t    *qp;      /* was DE */
   const char *message; /* was HL */
 
@@ -188,6 +239,7 @@ void next_message(tgestate_t *state)
   message = messages_table[*qp];
 
   state->messages.current_character = message;
+  state->messages.current_strip     = &message_strips.strips[*qp];
 
   /* Discard the first element. */
   memmove(&state->messages.queue[0], &state->messages.queue[2], 16);
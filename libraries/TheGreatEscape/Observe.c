@@ -0,0 +1,96 @@
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "TheGreatEscape/State.h"
+
+#include "TheGreatEscape/Items.h"
+#include "TheGreatEscape/Rooms.h"
+#include "TheGreatEscape/Types.h"
+#include "TheGreatEscape/Utils.h"
+#include "TheGreatEscape/TheGreatEscape.h"
+
+STATIC_ASSERT(TGE_OBSERVE_VISCHARS == vischars_LENGTH, observe_vischars);
+STATIC_ASSERT(TGE_OBSERVE_ITEMS == item__LIMIT, observe_items);
+STATIC_ASSERT(TGE_OBSERVE_NONE == item_NONE, observe_none);
+
+/**
+ * Conv: Added. Fill in an observation of the game's state.
+ *
+ * Reads the state only, so it's safe to call between any two calls of
+ * tge_main.
+ *
+ * \param[in]  state Pointer to game state.
+ * \param[out] obs   Observation.
+ */
+TGE_API void tge_observe(const tgestate_t *state, tgeobservation_t *obs)
+{
+  const vischar_t          *vischar;
+  tgeobservation_vischar_t *ovischar;
+  const itemstruct_t       *itemstr;
+  tgeobservation_item_t    *oitem;
+  item_t                    item;
+  int                       i;
+  uint8_t                   room; /* room_t plus itemstruct_ROOM_NONE */
+
+  assert(state != NULL);
+  assert(obs != NULL);
+
+  memset(obs, 0, sizeof(*obs));
+
+  vischar  = &state->vischars[0];
+  ovischar = &obs->vischars[0];
+  for (i = 0; i < vischars_LENGTH; i++)
+  {
+    ovischar->x         = vischar->mi.pos.x;
+    ovischar->y         = vischar->mi.pos.y;
+    ovischar->height    = vischar->mi.pos.height;
+    ovischar->character = vischar->character;
+    ovischar->room      = vischar->room;
+    ovischar->direction = vischar->direction;
+    ovischar->flags     = vischar->flags;
+    ovischar->input     = vischar->input;
+    if (vischar->flags == vischar_FLAGS_EMPTY_SLOT)
+      ovischar->character = TGE_OBSERVE_NONE;
+    vischar++;
+    ovischar++;
+  }
+
+  itemstr = &state->item_structs[0];
+  oitem   = &obs->items[0];
+  for (item = 0; item < item__LIMIT; item++)
+  {
+    room = itemstr->room_and_flags & itemstruct_ROOM_MASK;
+
+    oitem->x      = itemstr->pos.x;
+    oitem->y      = itemstr->pos.y;
+    oitem->height = itemstr->pos.height;
+    oitem->room   = (room == itemstruct_ROOM_NONE) ? TGE_OBSERVE_NONE : room;
+    oitem->held   = state->items_held[0] == item ||
+                    state->items_held[1] == item;
+    oitem->flags  = itemstr->item_and_flags & ~itemstruct_ITEM_MASK;
+    itemstr++;
+    oitem++;
+  }
+
+  for (i = 0; i < 3; i++)
+  {
+    obs->searchlights[i][0] = state->searchlight.states[i].xy.x;
+    obs->searchlights[i][1] = state->searchlight.states[i].xy.y;
+  }
+
+  obs->room              = state->room_index;
+  obs->items_held[0]     = state->items_held[0];
+  obs->items_held[1]     = state->items_held[1];
+  obs->morale            = state->morale;
+  obs->clock             = state->clock;
+  obs->day_or_night      = state->day_or_night;
+  obs->bell              = state->bell;
+  obs->searchlight_state = state->searchlight_state;
+  obs->game_counter      = state->game_counter;
+  obs->hero_in_bed       = state->hero_in_bed;
+  obs->hero_in_breakfast = state->hero_in_breakfast;
+  obs->red_flag          = state->red_flag;
+}
+
+// vim: ts=8 sts=2 sw=2 et
@@ -3,7 +3,8 @@
 
 #include "TheGreatEscape/RoomDefs.h"
 
-/* Room defintions are not const as they are updated when objects are altered. */
+/* Conv: Room definitions which the game alters are copied into each
+ * instance. See roomdefs_t. */
 
 /**
  * $6BAD: Room and tunnel definitions.
@@ -67,7 +68,7 @@ const roomdef_t *rooms_and_tunnels[room__LIMIT] =
   &roomdef_40[0],
 };
 
-uint8_t roomdef_1_hut1_right[] =
+const uint8_t roomdef_1_hut1_right[] =
 {
   0,
   3, // number of boundaries
@@ -89,7 +90,7 @@ uint8_t roomdef_1_hut1_right[] =
   interiorobject_DOOR_FRAME_SW,               7, 10,
 };
 
-uint8_t roomdef_2_hut2_left[] =
+const uint8_t roomdef_2_hut2_left[] =
 {
   1,
   2, // number of boundaries
@@ -108,7 +109,7 @@ uint8_t roomdef_2_hut2_left[] =
   interiorobject_SMALL_TUNNEL_ENTRANCE,       5,  9,
 };
 
-uint8_t roomdef_3_hut2_right[] =
+const uint8_t roomdef_3_hut2_right[] =
 {
   0,
   3, // number of boundaries
@@ -130,7 +131,7 @@ uint8_t roomdef_3_hut2_right[] =
   interiorobject_DOOR_FRAME_SW,               7, 10,
 };
 
-uint8_t roomdef_4_hut3_left[] =
+const uint8_t roomdef_4_hut3_left[] =
 {
   1,
   2, // number of boundaries
@@ -150,7 +151,7 @@ uint8_t roomdef_4_hut3_left[] =
   interiorobject_PAPERS_ON_FLOOR,                   14, 14,
 };
 
-uint8_t roomdef_5_hut3_right[] =
+const uint8_t roomdef_5_hut3_right[] =
 {
   0,
   3, // number of boundaries
@@ -172,7 +173,7 @@ uint8_t roomdef_5_hut3_right[] =
   interiorobject_DOOR_FRAME_SW,               7, 10,
 };
 
-uint8_t roomdef_8_corridor[] =
+const uint8_t roomdef_8_corridor[] =
 {
   2,
   0, // number of boundaries
@@ -186,7 +187,7 @@ uint8_t roomdef_8_corridor[] =
   interiorobject_SHORT_WARDROBE_FACING_SW,             18,  6,
 };
 
-uint8_t roomdef_9_crate[] =
+const uint8_t roomdef_9_crate[] =
 {
   1,
   1, // number of boundaries
@@ -206,7 +207,7 @@ uint8_t roomdef_9_crate[] =
   interiorobject_SMALL_CRATE,                 4,  9,
 };
 
-uint8_t roomdef_10_lockpick[] =
+const uint8_t roomdef_10_lockpick[] =
 {
   4,
   2, // number of boundaries
@@ -231,7 +232,7 @@ uint8_t roomdef_10_lockpick[] =
   interiorobject_TABLE,                       2,  6,
 };
 
-uint8_t roomdef_11_papers[] =
+const uint8_t roomdef_11_papers[] =
 {
   4,
   1, // number of boundaries
@@ -250,7 +251,7 @@ uint8_t roomdef_11_papers[] =
   interiorobject_DESK_FACING_SW,                       12, 10,
 };
 
-uint8_t roomdef_12_corridor[] =
+const uint8_t roomdef_12_corridor[] =
 {
   1,
   0, // number of boundaries
@@ -263,7 +264,7 @@ uint8_t roomdef_12_corridor[] =
   interiorobject_DOOR_FRAME_SE,              13, 10,
 };
 
-uint8_t roomdef_13_corridor[] =
+const uint8_t roomdef_13_corridor[] =
 {
   1,
   0, // number of boundaries
@@ -278,7 +279,7 @@ uint8_t roomdef_13_corridor[] =
   interiorobject_CHEST_OF_DRAWERS_FACING_SW,           14,  7,
 };
 
-uint8_t roomdef_14_torch[] =
+const uint8_t roomdef_14_torch[] =
 {
   0,
   3, // number of boundaries
@@ -299,7 +300,7 @@ uint8_t roomdef_14_torch[] =
   interiorobject_EMPTY_BED_FACING_SE,                   2,  9,
 };
 
-uint8_t roomdef_15_uniform[] =
+const uint8_t roomdef_15_uniform[] =
 {
   0,
   4, // number of boundaries
@@ -322,7 +323,7 @@ uint8_t roomdef_15_uniform[] =
   interiorobject_TABLE,                      18,  8,
 };
 
-uint8_t roomdef_16_corridor[] =
+const uint8_t roomdef_16_corridor[] =
 {
   1,
   0, // number of boundaries
@@ -335,7 +336,7 @@ uint8_t roomdef_16_corridor[] =
   interiorobject_DOOR_FRAME_SE,              13, 10,
 };
 
-uint8_t roomdef_7_corridor[] =
+const uint8_t roomdef_7_corridor[] =
 {
   1,
   0, // number of boundaries
@@ -348,7 +349,7 @@ uint8_t roomdef_7_corridor[] =
   interiorobject_TALL_WARDROBE_FACING_SW,              12,  4,
 };
 
-uint8_t roomdef_18_radio[] =
+const uint8_t roomdef_18_radio[] =
 {
   4,
   3, // number of boundaries
@@ -370,7 +371,7 @@ uint8_t roomdef_18_radio[] =
   interiorobject_DOOR_FRAME_SW,               5,  7,
 };
 
-uint8_t roomdef_19_food[] =
+const uint8_t roomdef_19_food[] =
 {
   1,
   1, // number of boundaries
@@ -391,7 +392,7 @@ uint8_t roomdef_19_food[] =
   interiorobject_DOOR_FRAME_SW,               9, 10,
 };
 
-uint8_t roomdef_20_redcross[] =
+const uint8_t roomdef_20_redcross[] =
 {
   1,
   2, // number of boundaries
@@ -413,7 +414,7 @@ uint8_t roomdef_20_redcross[] =
   interiorobject_TINY_TABLE,                 11,  8,
 };
 
-uint8_t roomdef_22_red_key[] =
+const uint8_t roomdef_22_red_key[] =
 {
   3,
   2, // number of boundaries
@@ -431,7 +432,7 @@ uint8_t roomdef_22_red_key[] =
   interiorobject_DOOR_FRAME_NE,              14,  4,
 };
 
-uint8_t roomdef_23_breakfast[] =
+const uint8_t roomdef_23_breakfast[] =
 {
   0,
   1, // number of boundaries
@@ -453,7 +454,7 @@ uint8_t roomdef_23_breakfast[] =
   interiorobject_EMPTY_BENCH,                 8,  7,
 };
 
-uint8_t roomdef_24_solitary[] =
+const uint8_t roomdef_24_solitary[] =
 {
   3,
   1, // number of boundaries
@@ -466,7 +467,7 @@ uint8_t roomdef_24_solitary[] =
   interiorobject_TINY_TABLE,                 10,  9,
 };
 
-uint8_t roomdef_25_breakfast[] =
+const uint8_t roomdef_25_breakfast[] =
 {
   0,
   1, // number of boundaries
@@ -486,7 +487,7 @@ uint8_t roomdef_25_breakfast[] =
   interiorobject_EMPTY_BENCH,                14,  4,
 };
 
-uint8_t roomdef_28_hut1_left[] =
+const uint8_t roomdef_28_hut1_left[] =
 {
   1,
   2, // number of boundaries
@@ -505,7 +506,7 @@ uint8_t roomdef_28_hut1_left[] =
   interiorobject_TABLE,                      11, 12,
 };
 
-uint8_t roomdef_29_second_tunnel_start[] =
+const uint8_t roomdef_29_second_tunnel_start[] =
 {
   5,
   0, // number of boundaries
@@ -520,7 +521,7 @@ uint8_t roomdef_29_second_tunnel_start[] =
   interiorobject_STRAIGHT_TUNNEL_SW_NE,                    0, 10,
 };
 
-uint8_t roomdef_31[] =
+const uint8_t roomdef_31[] =
 {
   6,
   0, // number of boundaries
@@ -535,7 +536,7 @@ uint8_t roomdef_31[] =
   interiorobject_STRAIGHT_TUNNEL_NW_SE,                   20, 10,
 };
 
-uint8_t roomdef_36[] =
+const uint8_t roomdef_36[] =
 {
   7,
   0, // number of boundaries
@@ -549,7 +550,7 @@ uint8_t roomdef_36[] =
   interiorobject_TUNNEL_CORNER_NE_SE,                   4,  8,
 };
 
-uint8_t roomdef_32[] =
+const uint8_t roomdef_32[] =
 {
   8,
   0, // number of boundaries
@@ -563,7 +564,7 @@ uint8_t roomdef_32[] =
   interiorobject_TUNNEL_CORNER_NW_SW,                  16,  8,
 };
 
-uint8_t roomdef_34[] =
+const uint8_t roomdef_34[] =
 {
   6,
   0, // number of boundaries
@@ -578,7 +579,7 @@ uint8_t roomdef_34[] =
   interiorobject_TUNNEL_ENTRANCE,                  20, 10,
 };
 
-uint8_t roomdef_35[] =
+const uint8_t roomdef_35[] =
 {
   6,
   0, // number of boundaries
@@ -593,7 +594,7 @@ uint8_t roomdef_35[] =
   interiorobject_STRAIGHT_TUNNEL_NW_SE,                   20, 10,
 };
 
-uint8_t roomdef_30[] =
+const uint8_t roomdef_30[] =
 {
   5,
   0, // number of boundaries
@@ -608,7 +609,7 @@ uint8_t roomdef_30[] =
   interiorobject_STRAIGHT_TUNNEL_SW_NE,                    0, 10,
 };
 
-uint8_t roomdef_40[] =
+const uint8_t roomdef_40[] =
 {
   9,
   0, // number of boundaries
@@ -623,7 +624,7 @@ uint8_t roomdef_40[] =
   interiorobject_STRAIGHT_TUNNEL_SW_NE,                    0, 10,
 };
 
-uint8_t roomdef_44[] =
+const uint8_t roomdef_44[] =
 {
   8,
   0, // number of boundaries
@@ -637,7 +638,7 @@ uint8_t roomdef_44[] =
   interiorobject_TUNNEL_CORNER_NW_NE,                  16,  8,
 };
 
-uint8_t roomdef_50_blocked_tunnel[] =
+const uint8_t roomdef_50_blocked_tunnel[] =
 {
   5,
   1, // number of boundaries
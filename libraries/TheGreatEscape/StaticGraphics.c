@@ -161,19 +161,40 @@ void plot_statics_and_menu_text(tgestate_t *state)
     { 0x102C, 12, "FOR NEW GAME"            },
   };
 
+  int                      iters;     /* was B */
+  const screenlocstring_t *slstring;  /* was HL */
+
+  assert(state != NULL);
+
+  plot_statics(state);
+
+  /* Plot menu text. */
+  iters    = NELEMS(key_choice_screenlocstrings);
+  slstring = &key_choice_screenlocstrings[0];
+  do
+    slstring = screenlocstring_plot(state, slstring);
+  while (--iters);
+}
+
+/**
+ * Conv: Added. Plot statics only. Split out of plot_statics_and_menu_text
+ * for starting without the menu.
+ *
+ * \param[in] state Pointer to game state.
+ */
+void plot_statics(tgestate_t *state)
+{
   const statictileline_t  *stline;    /* was HL */
   int                      iters;     /* was B */
   uint8_t                 *screenptr; /* was DE */
-  const screenlocstring_t *slstring;  /* was HL */
 
   assert(state != NULL);
 
-  /* Plot statics and menu text. */
   stline = &static_graphic_defs[0];
   iters  = NELEMS(static_graphic_defs);
   do
   {
-    screenptr = &state->speccy->screen[stline->screenloc]; /* Fetch screen address offset. */
+    screenptr = screen_address(state, stline->screenloc); /* Fetch screen address offset. */
     ASSERT_SCREEN_PTR_VALID(screenptr);
 
     if (stline->flags_and_length & statictileline_VERTICAL)
@@ -183,13 +204,6 @@ void plot_statics_and_menu_text(tgestate_t *state)
     stline++;
   }
   while (--iters);
-
-  /* Plot menu text. */
-  iters    = NELEMS(key_choice_screenlocstrings);
-  slstring = &key_choice_screenlocstrings[0];
-  do
-    slstring = screenlocstring_plot(state, slstring);
-  while (--iters);
 }
 
 /**
@@ -250,8 +264,6 @@ static void plot_static_tiles(tgestate_t             *state,
     const static_tile_t *static_tile; /* was HL' */
     const tilerow_t     *tile_data;   /* was HL' */
     int                  iters;       /* was B' */
-    ptrdiff_t            soffset;     /* was A */
-    int                  aoffset;
 
     tile_index = *tiles++;
 
@@ -263,21 +275,16 @@ static void plot_static_tiles(tgestate_t             *state,
     do
     {
       *out = *tile_data++;
-      out += 256; /* move to next screen row */
+      out += state->cell_scanline_stride; /* move to next screen row */
     }
     while (--iters);
-    out -= 256;
+    out -= state->cell_scanline_stride;
 
     /* Calculate screen attribute address of tile. */
-    // ((out - screen_base) / 0x800) * 0x100 + attr_base
-    soffset = out - &state->speccy->screen[0];
-    aoffset = soffset & 0xFF;
-    if (soffset >= 0x0800) aoffset += 256;
-    if (soffset >= 0x1000) aoffset += 256;
-    state->speccy->attributes[aoffset] = static_tile->attr; /* Copy attribute byte. */
+    *screen_attribute_address(state, out) = static_tile->attr; /* Copy attribute byte. */
 
     if (orientation == 0) /* Horizontal */
-      out = out - 7 * 256 + 1;
+      out = out - 7 * state->cell_scanline_stride + 1;
     else /* Vertical */
       out = (uint8_t *) get_next_scanline(state, out); // must cast away constness
 
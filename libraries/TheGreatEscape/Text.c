@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <string.h>
 
 #include "TheGreatEscape/Font.h"
 #include "TheGreatEscape/State.h"
@@ -9,17 +10,18 @@
 /**
  * $7D2F: Plot a single glyph (indirectly).
  *
+ * \param[in] state      Pointer to game state.
  * \param[in] pcharacter Pointer to character to plot. (was HL)
  * \param[in] output     Where to plot.                (was DE)
  *
  * \return Pointer to next character along.
  */
-uint8_t *plot_glyph(const char *pcharacter, uint8_t *output)
+uint8_t *plot_glyph(tgestate_t *state, const char *pcharacter, uint8_t *output)
 {
   assert(pcharacter != NULL);
   assert(output     != NULL);
 
-  return plot_single_glyph(*pcharacter, output);
+  return plot_single_glyph(state, *pcharacter, output);
 }
 
 /**
@@ -27,18 +29,20 @@ uint8_t *plot_glyph(const char *pcharacter, uint8_t *output)
  *
  * Conv: Characters are specified in ASCII.
  *
+ * \param[in] state     Pointer to game state.
  * \param[in] character Character to plot. (was HL)
  * \param[in] output    Where to plot.     (was DE)
  *
  * \return Pointer to next character along. (was DE)
  */
-uint8_t *plot_single_glyph(int character, uint8_t *output)
+uint8_t *plot_single_glyph(tgestate_t *state, int character, uint8_t *output)
 {
   const tile_t    *glyph;        /* was HL */
   const tilerow_t *row;          /* was HL */
   int              iters;        /* was B */
   uint8_t         *saved_output; /* was stacked */
 
+  assert(state != NULL);
   assert(character < 256);
   assert(output != NULL);
 
@@ -50,7 +54,7 @@ uint8_t *plot_single_glyph(int character, uint8_t *output)
   do
   {
     *output = *row++;
-    output += 256; /* Advance to next row. */
+    output += state->cell_scanline_stride; /* Advance to next row. */
   }
   while (--iters);
 
@@ -58,6 +62,69 @@ uint8_t *plot_single_glyph(int character, uint8_t *output)
   return ++saved_output;
 }
 
+/**
+ * Conv: Pre-render a string from the font.
+ *
+ * Characters are specified in ASCII.
+ *
+ * \param[in]  string String to render.
+ * \param[in]  length Length of string, in characters.
+ * \param[out] strip  Rendered strip.
+ */
+void render_text_strip(const char *string, int length, textstrip_t *strip)
+{
+  const tile_t *glyph;
+  int           i;
+  int           row;
+
+  assert(string != NULL);
+  assert(length > 0 && length <= textstrip_MAX_LENGTH);
+  assert(strip  != NULL);
+
+  strip->length = (uint8_t) length;
+  for (i = 0; i < length; i++)
+  {
+    glyph = &bitmap_font[ascii_to_font[(unsigned char) string[i]]];
+    for (row = 0; row < 8; row++)
+      strip->rows[row][i] = glyph->row[row];
+  }
+}
+
+/**
+ * Conv: Plot characters from a pre-rendered strip.
+ *
+ * \param[in] state  Pointer to game state.
+ * \param[in] strip  Strip to plot from.
+ * \param[in] first  Index of the first character to plot.
+ * \param[in] count  Number of characters to plot.
+ * \param[in] output Where to plot the first character.
+ *
+ * \return Pointer to next character along.
+ */
+uint8_t *plot_text_strip(tgestate_t        *state,
+                         const textstrip_t *strip,
+                         int                first,
+                         int                count,
+                         uint8_t           *output)
+{
+  int      row;
+  uint8_t *saved_output;
+
+  assert(state  != NULL);
+  assert(strip  != NULL);
+  assert(first >= 0 && count > 0 && first + count <= strip->length);
+  assert(output != NULL);
+
+  saved_output = output;
+  for (row = 0; row < 8; row++)
+  {
+    memcpy(output, &strip->rows[row][first], count);
+    output += state->cell_scanline_stride;
+  }
+
+  return saved_output + count;
+}
+
 /* ----------------------------------------------------------------------- */
 
 // vim: ts=8 sts=2 sw=2 et
@@ -49,6 +49,7 @@
 
 #include "TheGreatEscape/TheGreatEscape.h"
 
+#include "TheGreatEscape/Assets.h"
 #include "TheGreatEscape/Doors.h"
 #include "TheGreatEscape/ExteriorTiles.h"
 #include "TheGreatEscape/Input.h"
@@ -173,6 +174,10 @@ void enter_room(tgestate_t *state)
   state->game_window_offset.y = 0;
   setup_room(state);
   plot_interior_tiles(state);
+  /* Conv: The zoombox shows the new room, so render it in full even when
+   * the current frame isn't being rendered. */
+  state->rendering    = 1;
+  state->window_stale = 0;
   state->map_position.x = 0x74;
   state->map_position.y = 0xEA;
   set_hero_sprite_for_room(state);
@@ -252,19 +257,19 @@ void setup_movable_items(tgestate_t *state)
   switch (state->room_index)
   {
     case room_2_HUT2LEFT:
-      movableitem = &state->movable_items[movable_item_STOVE1];
+      movableitem = &state->cold.movable_items[movable_item_STOVE1];
       character   = character_26_STOVE_1;
       setup_movable_item(state, movableitem, character);
       break;
 
     case room_4_HUT3LEFT:
-      movableitem = &state->movable_items[movable_item_STOVE2];
+      movableitem = &state->cold.movable_items[movable_item_STOVE2];
       character   = character_27_STOVE_2;
       setup_movable_item(state, movableitem, character);
       break;
 
     case room_9_CRATE:
-      movableitem = &state->movable_items[movable_item_CRATE];
+      movableitem = &state->cold.movable_items[movable_item_CRATE];
       character   = character_28_CRATE;
       setup_movable_item(state, movableitem, character);
       break;
@@ -435,6 +440,36 @@ void wipe_visible_tiles(tgestate_t *state)
 
 /* ----------------------------------------------------------------------- */
 
+/**
+ * Conv: Added. Return the definition of the given room, using the
+ * instance's copy for the rooms which the game alters.
+ *
+ * \param[in] state Pointer to game state.
+ * \param[in] index Room index.
+ *
+ * \return Pointer to room definition.
+ */
+static const roomdef_t *get_roomdef(const tgestate_t *state, room_t index)
+{
+  switch (index)
+  {
+    case room_2_HUT2LEFT:
+      return &state->cold.roomdefs.hut2_left[0];
+    case room_3_HUT2RIGHT:
+      return &state->cold.roomdefs.hut2_right[0];
+    case room_5_HUT3RIGHT:
+      return &state->cold.roomdefs.hut3_right[0];
+    case room_23_BREAKFAST:
+      return &state->cold.roomdefs.breakfast_23[0];
+    case room_25_BREAKFAST:
+      return &state->cold.roomdefs.breakfast_25[0];
+    case room_50_BLOCKED_TUNNEL:
+      return &state->cold.roomdefs.blocked_tunnel[0];
+    default:
+      return rooms_and_tunnels[index - 1]; /* array starts with room 1 */
+  }
+}
+
 /**
  * $6A35: Setup room.
  *
@@ -512,7 +547,7 @@ void setup_room(tgestate_t *state)
 
   assert(state->room_index >= 0);
   assert(state->room_index < room__LIMIT);
-  proomdef = rooms_and_tunnels[state->room_index - 1]; /* array starts with room 1 */
+  proomdef = get_roomdef(state, state->room_index);
 
   setup_doors(state);
 
@@ -698,28 +733,27 @@ range:
  * $6B42: Expand all of the tile indices in the tiles buffer to full tiles in
  * the screen buffer.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of plot_interior_tiles for each renderer.
+ *
+ * \param[in] state   Pointer to game state.
+ * \param[in] columns Columns in the window. (Conv: added)
+ * \param[in] rows    Rows in the window. (Conv: added)
  */
-void plot_interior_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_interior_tiles_common(tgestate_t *state,
+                                                     int         columns,
+                                                     int         rows)
 {
-  int                rows;          /* added */
-  int                columns;       /* added */
   uint8_t           *window_buf;    /* was HL */
   const tileindex_t *tiles_buf;     /* was DE */
   int                rowcounter;    /* was C */
   int                columncounter; /* was B */
-  int                iters;         /* was B */
-  int                stride;        /* was C */
 
   assert(state != NULL);
 
-  rows       = state->rows - 1; // 16
-  columns    = state->columns; // 24
-
   window_buf = state->window_buf;
   tiles_buf  = state->tile_buf;
 
-  rowcounter = rows;
+  rowcounter = rows - 1; // 16
   do
   {
     columncounter = columns;
@@ -730,21 +764,22 @@ void plot_interior_tiles(tgestate_t *state)
 
       ASSERT_TILE_BUF_PTR_VALID(tiles_buf);
 
-      tile_data = &interior_tiles[*tiles_buf].row[0];
+      tile_data = &assets->interior_tiles[*tiles_buf].row[0];
 
       window_buf2 = window_buf;
 
-      iters  = 8;
-      stride = columns;
-      do
-      {
-        ASSERT_WINDOW_BUF_PTR_VALID(window_buf2);
-        ASSERT_INTERIOR_TILES_VALID(tile_data);
+      ASSERT_WINDOW_BUF_PTR_VALID(window_buf2 + 7 * columns);
+      ASSERT_INTERIOR_TILES_VALID(tile_data);
 
-        *window_buf2 = *tile_data++;
-        window_buf2 += stride;
-      }
-      while (--iters);
+      /* Conv: Unrolled. The stride is an immediate in the fixed size renderer. */
+      window_buf2[0 * columns] = tile_data[0];
+      window_buf2[1 * columns] = tile_data[1];
+      window_buf2[2 * columns] = tile_data[2];
+      window_buf2[3 * columns] = tile_data[3];
+      window_buf2[4 * columns] = tile_data[4];
+      window_buf2[5 * columns] = tile_data[5];
+      window_buf2[6 * columns] = tile_data[6];
+      window_buf2[7 * columns] = tile_data[7];
 
       tiles_buf++;
       window_buf++; // move to next character position
@@ -753,6 +788,8 @@ void plot_interior_tiles(tgestate_t *state)
     window_buf += 7 * columns; // move to next row
   }
   while (--rowcounter);
+
+  invalidate_game_window(state);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -761,17 +798,37 @@ void plot_interior_tiles(tgestate_t *state)
  * $6B79: Locations of beds.
  *
  * Used by wake_up, character_sleeps and reset_map_and_characters.
+ *
+ * Conv: Pointers into the room definitions in the original. These are
+ * offsets into an instance's roomdefs_t instead. Use get_bed.
  */
-uint8_t *const beds[beds_LENGTH] =
+static const uint16_t beds[beds_LENGTH] =
 {
-  &roomdef_3_hut2_right[29],
-  &roomdef_3_hut2_right[32],
-  &roomdef_3_hut2_right[35],
-  &roomdef_5_hut3_right[29],
-  &roomdef_5_hut3_right[32],
-  &roomdef_5_hut3_right[35],
+  offsetof(roomdefs_t, hut2_right) + 29,
+  offsetof(roomdefs_t, hut2_right) + 32,
+  offsetof(roomdefs_t, hut2_right) + 35,
+  offsetof(roomdefs_t, hut3_right) + 29,
+  offsetof(roomdefs_t, hut3_right) + 32,
+  offsetof(roomdefs_t, hut3_right) + 35,
 };
 
+/**
+ * Conv: Added. Return the given bed's object in the instance's room
+ * definitions.
+ *
+ * \param[in] state Pointer to game state.
+ * \param[in] bed   Index into beds[].
+ *
+ * 
+eturn Pointer to bed object.
+ */
+static uint8_t *get_bed(tgestate_t *state, int bed)
+{
+  assert(bed >= 0 && bed < beds_LENGTH);
+
+  return (uint8_t *) &state->cold.roomdefs + beds[bed];
+}
+
 /* ----------------------------------------------------------------------- */
 
 /**
@@ -1314,14 +1371,14 @@ void draw_item(tgestate_t *state, item_t item, size_t dstoff)
 {
   assert(state != NULL);
 
-  uint8_t *const screen = &state->speccy->screen[0];
+  uint8_t *const screenptr = screen_address(state, dstoff); /* Conv: Added */
 
   attribute_t       *attrs;  /* was HL */
   attribute_t        attr;   /* was A */
   const spritedef_t *sprite; /* was HL */
 
   /* Wipe item. */
-  screen_wipe(state, 2, 16, screen + dstoff);
+  screen_wipe(state, 2, 16, screenptr);
 
   if (item == item_NONE)
     return;
@@ -1330,18 +1387,18 @@ void draw_item(tgestate_t *state, item_t item, size_t dstoff)
 
   /* Set screen attributes. */
   attrs = (dstoff & 0xFF) + &state->speccy->attributes[0x5A00 - SCREEN_ATTRIBUTES_START_ADDRESS];
-  attr = state->item_attributes[item];
+  attr = state->cold.item_attributes[item];
   attrs[0] = attr;
   attrs[1] = attr;
 
   /* Move to next attribute row. */
-  attrs += state->width;
+  attrs += state->cold.width;
   attrs[0] = attr;
   attrs[1] = attr;
 
   /* Plot the item bitmap. */
   sprite = &item_definitions[item];
-  plot_bitmap(state, sprite->width, sprite->height, sprite->bitmap, screen + dstoff);
+  plot_bitmap(state, sprite->width, sprite->height, sprite->bitmap, screenptr);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -1484,6 +1541,9 @@ uint8_t *get_next_scanline(tgestate_t *state, uint8_t *slp)
   uint16_t       offset; /* was HL */
   uint16_t       delta;  /* was DE */
 
+  if (state->speccy->layout == zxlayout_LINEAR)
+    return slp + 32; /* Conv: Added. */
+
   offset = slp - screen;
 
   assert(offset < 0x8000);
@@ -1502,6 +1562,102 @@ uint8_t *get_next_scanline(tgestate_t *state, uint8_t *slp)
   return screen + (int16_t) offset;
 }
 
+/**
+ * Conv: Given an offset into the Spectrum's interleaved screen, return the
+ * same position in the logical screen, whichever layout it uses.
+ *
+ * The game's tables of screen positions are kept as Spectrum offsets.
+ *
+ * \param[in] state  Pointer to game state.
+ * \param[in] offset Spectrum screen offset.
+ *
+ * \return Screen pointer.
+ */
+uint8_t *screen_address(tgestate_t *state, uint16_t offset)
+{
+  unsigned int y;
+
+  assert(state != NULL);
+  assert(offset < SCREEN_LENGTH);
+
+  if (state->speccy->layout == zxlayout_LINEAR)
+  {
+    /* 0b000BBLLLRRRCCCCC -> scanline 0bBBRRRLLL */
+    y = ((offset >> 5) & 0xC0) | ((offset >> 2) & 0x38) | ((offset >> 8) & 0x07);
+    offset = (uint16_t) (y * 32 + (offset & 0x1F));
+  }
+
+  return &state->speccy->screen[offset];
+}
+
+/**
+ * Conv: Given a screen address, return the address of its attribute.
+ *
+ * \param[in] state Pointer to game state.
+ * \param[in] addr  Screen address.
+ *
+ * \return Attribute address.
+ */
+attribute_t *screen_attribute_address(tgestate_t *state, const uint8_t *addr)
+{
+  ptrdiff_t off;
+
+  assert(state != NULL);
+  ASSERT_SCREEN_PTR_VALID(addr);
+
+  off = addr - &state->speccy->screen[0];
+  if (state->speccy->layout == zxlayout_LINEAR)
+    return &state->speccy->attributes[(off >> 8) * 32 + (off & 0x1F)];
+  else
+    return &state->speccy->attributes[((off >> 11) << 8) | (off & 0xFF)];
+}
+
+/**
+ * Conv: Given a screen address, return the same position one character row
+ * down.
+ *
+ * \param[in] state Pointer to game state.
+ * \param[in] addr  Screen address.
+ *
+ * \return Screen address.
+ */
+uint8_t *get_next_char_row(tgestate_t *state, uint8_t *addr)
+{
+  assert(state != NULL);
+  assert(addr  != NULL);
+
+  if (state->speccy->layout == zxlayout_LINEAR)
+    return addr + 32 * 8;
+
+  if (((addr - &state->speccy->screen[0]) & 0xFF) >= 224)
+    return addr + 32 + 0x0700; /* Skip to the next third. */
+  else
+    return addr + 32;
+}
+
+/**
+ * Conv: Given a screen address, return the same position one character row
+ * up.
+ *
+ * \param[in] state Pointer to game state.
+ * \param[in] addr  Screen address.
+ *
+ * \return Screen address.
+ */
+uint8_t *get_prev_char_row(tgestate_t *state, uint8_t *addr)
+{
+  assert(state != NULL);
+  assert(addr  != NULL);
+
+  if (state->speccy->layout == zxlayout_LINEAR)
+    return addr - 32 * 8;
+
+  if (((addr - &state->speccy->screen[0]) & 0xFF) < 32)
+    return addr - 32 - 0x0700; /* Skip to the previous third. */
+  else
+    return addr - 32;
+}
+
 /* ----------------------------------------------------------------------- */
 
 /**
@@ -1511,12 +1667,22 @@ void main_loop(tgestate_t *state)
 {
   assert(state != NULL);
 
+  choose_whether_to_render(state);
+
   check_morale(state);
   keyscan_break(state);
   message_display(state);
   process_player_input(state);
   in_permitted_area(state);
-  restore_tiles(state);
+  /* Conv: Tiles are restored only when rendering. After skipped frames
+   * the whole window is repainted instead. */
+  if (state->rendering)
+  {
+    if (state->window_stale)
+      repaint_game_window(state);
+    else
+      restore_tiles(state);
+  }
   move_characters(state);
   follow_suspicious_character(state);
   purge_visible_characters(state);
@@ -1528,7 +1694,10 @@ void main_loop(tgestate_t *state)
   message_display(state); /* second */
   ring_bell(state); /* second */
   locate_vischar_or_itemstruct_then_plot(state);
-  plot_game_window(state);
+  /* Conv: Skip the screen copy when the frame pacer has fallen behind or
+   * when this frame isn't rendered. */
+  if (state->rendering && !state->speccy->frame_skip)
+    plot_game_window(state);
   ring_bell(state); /* third */
   if (state->day_or_night != 0)
     nighttime(state);
@@ -1541,6 +1710,57 @@ void main_loop(tgestate_t *state)
 
 /* ----------------------------------------------------------------------- */
 
+/**
+ * Conv: Decide whether the current frame renders the game window.
+ *
+ * \param[in] state Pointer to game state.
+ */
+void choose_whether_to_render(tgestate_t *state)
+{
+  assert(state != NULL);
+
+  state->rendering = 0;
+  if (state->render_requested)
+  {
+    state->render_requested = 0;
+    state->rendering = 1;
+  }
+  if (state->render_interval > 0 && --state->render_countdown <= 0)
+  {
+    state->render_countdown = state->render_interval;
+    state->rendering = 1;
+  }
+
+  if (!state->rendering)
+    state->window_stale = 1;
+}
+
+/**
+ * Conv: Repaint the whole game window from the tiles, after frames which
+ * weren't rendered left it out of date.
+ *
+ * \param[in] state Pointer to game state.
+ */
+void repaint_game_window(tgestate_t *state)
+{
+  assert(state != NULL);
+
+  if (state->room_index > room_0_OUTDOORS)
+  {
+    plot_interior_tiles(state);
+  }
+  else
+  {
+    get_supertiles(state);
+    plot_all_tiles(state);
+  }
+  invalidate_game_window(state);
+
+  state->window_stale = 0;
+}
+
+/* ----------------------------------------------------------------------- */
+
 /**
  * $9DCF: Check morale level, report if (near) zero and inhibit player
  * control.
@@ -1583,8 +1803,8 @@ void keyscan_break(tgestate_t *state)
   assert(state != NULL);
 
   /* Is shift-space (break) pressed? */
-  space = (state->speccy->in(state->speccy, port_KEYBOARD_SPACESYMSHFTMNB) & 0x01) == 0;
-  shift = (state->speccy->in(state->speccy, port_KEYBOARD_SHIFTZXCV)       & 0x01) == 0;
+  space = (zxinput_read(&state->speccy->input, port_KEYBOARD_SPACESYMSHFTMNB) & 0x01) == 0;
+  shift = (zxinput_read(&state->speccy->input, port_KEYBOARD_SHIFTZXCV)       & 0x01) == 0;
   if (!space || !shift)
     return; /* not pressed */
 
@@ -1598,6 +1818,8 @@ void keyscan_break(tgestate_t *state)
   if (state->room_index == room_0_OUTDOORS)
   {
     reset_outdoors(state);
+    /* Conv: The main loop carries on from here, so finish the zoombox. */
+    zoombox_open(state);
   }
   else
   {
@@ -1671,7 +1893,7 @@ void process_player_input(tgestate_t *state)
         state->vischars[0].target.y       = 0x00;
         state->vischars[0].mi.pos.x       = 0x34;
         state->vischars[0].mi.pos.y       = 0x3E;
-        roomdef_25_breakfast[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
+        state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
         state->hero_in_breakfast = 0;
       }
       else
@@ -1684,7 +1906,7 @@ void process_player_input(tgestate_t *state)
         state->vischars[0].mi.pos.x       = 0x2E;
         state->vischars[0].mi.pos.y       = 0x2E;
         state->vischars[0].mi.pos.height  = 24;
-        roomdef_2_hut2_left[roomdef_2_BED] = interiorobject_EMPTY_BED_FACING_SE;
+        state->cold.roomdefs.hut2_left[roomdef_2_BED] = interiorobject_EMPTY_BED_FACING_SE;
         state->hero_in_bed = 0;
       }
 
@@ -1719,7 +1941,7 @@ void picking_a_lock(tgestate_t *state)
     return;
 
   /* Countdown reached: Unlock the door. */
-  *state->ptr_to_door_being_lockpicked &= ~door_LOCKED;
+  *state->cold.ptr_to_door_being_lockpicked &= ~door_LOCKED;
   queue_message_for_display(state, message_IT_IS_OPEN);
 
   state->vischars[0].flags &= ~(vischar_FLAGS_PICKING_LOCK | vischar_FLAGS_CUTTING_WIRE);
@@ -2055,21 +2277,21 @@ void wave_morale_flag(tgestate_t *state)
     {
       /* Decreasing morale. */
       (*pdisplayed_morale)--;
-      pdisplayed_morale = get_next_scanline(state, state->moraleflag_screen_address);
+      pdisplayed_morale = get_next_scanline(state, state->cold.moraleflag_screen_address);
     }
     else
     {
       /* Increasing morale. */
       (*pdisplayed_morale)++;
-      pdisplayed_morale = get_prev_scanline(state, state->moraleflag_screen_address);
+      pdisplayed_morale = get_prev_scanline(state, state->cold.moraleflag_screen_address);
     }
-    state->moraleflag_screen_address = pdisplayed_morale;
+    state->cold.moraleflag_screen_address = pdisplayed_morale;
   }
 
   flag_bitmap = flag_down;
   if (*pgame_counter & 2)
     flag_bitmap = flag_up;
-  plot_bitmap(state, 3, 25, flag_bitmap, state->moraleflag_screen_address);
+  plot_bitmap(state, 3, 25, flag_bitmap, state->cold.moraleflag_screen_address);
 }
 
 /* ----------------------------------------------------------------------- */
@@ -2095,7 +2317,7 @@ void set_morale_flag_screen_attributes(tgestate_t *state, attribute_t attrs)
     pattrs[0] = attrs;
     pattrs[1] = attrs;
     pattrs[2] = attrs;
-    pattrs += state->width;
+    pattrs += state->cold.width;
   }
   while (--iters);
 }
@@ -2119,6 +2341,9 @@ uint8_t *get_prev_scanline(tgestate_t *state, uint8_t *addr)
   uint8_t *const screen = &state->speccy->screen[0];
   uint16_t       raddr = addr - screen;
 
+  if (state->speccy->layout == zxlayout_LINEAR)
+    return addr - 32; /* Conv: Added. */
+
   if ((raddr & 0x0700) != 0)
   {
     // NNN bits
@@ -2200,7 +2425,7 @@ void ring_bell(tgestate_t *state)
   }
 
   /* Fetch visible state of bell. */
-  bell = state->speccy->screen[screenoffset_BELL_RINGER];
+  bell = *screen_address(state, screenoffset_BELL_RINGER);
   if (bell != 0x3F) /* Pixel value is 0x3F if on */
   {
     /* Plot ringer "on". */
@@ -2228,7 +2453,7 @@ void plot_ringer(tgestate_t *state, const uint8_t *src)
   plot_bitmap(state,
               1, 12, /* dimensions: 8 x 12 */
               src,
-              &state->speccy->screen[screenoffset_BELL_RINGER]);
+              screen_address(state, screenoffset_BELL_RINGER));
 }
 
 /* ----------------------------------------------------------------------- */
@@ -2324,13 +2549,13 @@ void increase_score(tgestate_t *state, uint8_t delta)
 
   /* Increment the score digit-wise until delta is zero. */
 
-  assert(state->score_digits[0] <= 9);
-  assert(state->score_digits[1] <= 9);
-  assert(state->score_digits[2] <= 9);
-  assert(state->score_digits[3] <= 9);
-  assert(state->score_digits[4] <= 9);
+  assert(state->cold.score_digits[0] <= 9);
+  assert(state->cold.score_digits[1] <= 9);
+  assert(state->cold.score_digits[2] <= 9);
+  assert(state->cold.score_digits[3] <= 9);
+  assert(state->cold.score_digits[4] <= 9);
 
-  pdigit = &state->score_digits[4];
+  pdigit = &state->cold.score_digits[4];
   do
   {
     char *tmp; /* was HL */
@@ -2366,14 +2591,14 @@ void plot_score(tgestate_t *state)
 
   assert(state != NULL);
 
-  digits = &state->score_digits[0];
-  screen = &state->speccy->screen[score_address];
-  iters = NELEMS(state->score_digits);
+  digits = &state->cold.score_digits[0];
+  screen = screen_address(state, score_address);
+  iters = NELEMS(state->cold.score_digits);
   do
   {
     char digit = '0' + *digits; /* Conv: Pass as ASCII. */
 
-    screen = plot_glyph(&digit, screen);
+    screen = plot_glyph(state, &digit, screen);
     digits++;
     screen++; /* Additionally to plot_glyph, so screen += 2 each iter. */
   }
@@ -2433,7 +2658,7 @@ void set_game_window_attributes(tgestate_t *state, attribute_t attrs)
 
   attributes = &state->speccy->attributes[0x0047];
   rows   = state->rows - 1;
-  stride = state->width - (state->columns - 1); /* e.g. 32 - 23 = 9 */
+  stride = state->cold.width - (state->columns - 1); /* e.g. 32 - 23 = 9 */
   do
   {
     uint8_t iters;
@@ -2666,7 +2891,7 @@ void event_new_red_cross_parcel(tgestate_t *state)
   return;
 
 found:
-  state->red_cross_parcel_current_contents = *item;
+  state->cold.red_cross_parcel_current_contents = *item;
   memcpy(&state->item_structs[item_RED_CROSS_PARCEL].room_and_flags,
          &red_cross_parcel_reset_data.room_and_flags,
          6);
@@ -2748,7 +2973,7 @@ void wake_up(tgestate_t *state)
 {
   characterstruct_t *charstr;  /* was HL */
   uint8_t            iters;    /* was B */
-  uint8_t *const    *bedpp;    /* was HL */
+  int                bed;      /* was HL */
 
   assert(state != NULL);
 
@@ -2786,15 +3011,14 @@ void wake_up(tgestate_t *state)
   set_prisoners_and_guards_target_B(state, &target_0500);
 
   /* Update all the bed objects to be empty. */
-  // FIXME: This writes to a possibly shared structure, so ought to be moved into the state somehow.
-  bedpp = &beds[0];
+  bed = 0;
   iters = beds_LENGTH; /* Bug: Conv: Original code uses 7 which is wrong. */
   do
-    **bedpp++ = interiorobject_EMPTY_BED_FACING_SE;
+    *get_bed(state, bed++) = interiorobject_EMPTY_BED_FACING_SE;
   while (--iters);
 
   /* Update the hero's bed object to be empty and redraw if required. */
-  roomdef_2_hut2_left[roomdef_2_BED] = interiorobject_EMPTY_BED_FACING_SE;
+  state->cold.roomdefs.hut2_left[roomdef_2_BED] = interiorobject_EMPTY_BED_FACING_SE;
   if (state->room_index != room_0_OUTDOORS && state->room_index < room_6)
   {
     setup_room(state);
@@ -2846,14 +3070,13 @@ void end_of_breakfast(tgestate_t *state)
   set_prisoners_and_guards_target_B(state, &target_9003_also);
 
   /* Update all the benches to be empty. */
-  // FIXME: Writing to shared state.
-  roomdef_23_breakfast[roomdef_23_BENCH_A] = interiorobject_EMPTY_BENCH;
-  roomdef_23_breakfast[roomdef_23_BENCH_B] = interiorobject_EMPTY_BENCH;
-  roomdef_23_breakfast[roomdef_23_BENCH_C] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_D] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_E] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_F] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_A] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_B] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_C] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_D] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_E] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_F] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
 
   if (state->room_index == room_0_OUTDOORS ||
       state->room_index >= room_29_SECOND_TUNNEL_START)
@@ -3214,11 +3437,11 @@ void character_sits(tgestate_t *state,
 
   index = x - 18;
   /* First three characters. */
-  bench = &roomdef_25_breakfast[roomdef_25_BENCH_D];
+  bench = &state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_D];
   if (index >= 3)
   {
     /* Second three characters. */
-    bench = &roomdef_23_breakfast[roomdef_23_BENCH_A];
+    bench = &state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_A];
     index -= 3;
   }
 
@@ -3255,7 +3478,7 @@ void character_sleeps(tgestate_t *state,
   assert(target != NULL);
 
   /* Poke object. */
-  *beds[x - 7] = interiorobject_OCCUPIED_BED;
+  *get_bed(state, x - 7) = interiorobject_OCCUPIED_BED;
 
   if (x < 10)
     room = room_3_HUT2RIGHT;
@@ -3343,7 +3566,7 @@ void hero_sits(tgestate_t *state)
 {
   assert(state != NULL);
 
-  roomdef_25_breakfast[roomdef_25_BENCH_G] = interiorobject_PRISONER_SAT_END_TABLE;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_G] = interiorobject_PRISONER_SAT_END_TABLE;
   hero_sit_sleep_common(state, &state->hero_in_breakfast);
 }
 
@@ -3356,7 +3579,7 @@ void hero_sleeps(tgestate_t *state)
 {
   assert(state != NULL);
 
-  roomdef_2_hut2_left[roomdef_2_BED] = interiorobject_OCCUPIED_BED;
+  state->cold.roomdefs.hut2_left[roomdef_2_BED] = interiorobject_OCCUPIED_BED;
   hero_sit_sleep_common(state, &state->hero_in_bed);
 }
 
@@ -3550,6 +3773,7 @@ void screen_reset(tgestate_t *state)
   wipe_visible_tiles(state);
   plot_interior_tiles(state);
   zoombox(state);
+  zoombox_open(state); /* Conv: Text is drawn over the window next. */
   plot_game_window(state);
   set_game_window_attributes(state, attribute_WHITE_OVER_BLACK);
 }
@@ -3641,13 +3865,25 @@ void escaped(tgestate_t *state)
   message = &messages[10]; /* PRESS ANY KEY */
   (void) screenlocstring_plot(state, message);
 
+  state->speccy->kick(state->speccy);
+
   /* Wait for a keypress. */
-  do
+  /* Conv: The original spins reading the ports. Input is now latched, so
+   * sleep between scans to let it change. */
+  for (;;)
+  {
     keys = keyscan_all(state);
-  while (keys != 0); /* Down press */
-  do
+    if (keys == 0)
+      break; /* Down press */
+    state->speccy->sleep(state->speccy, sleeptype_KEYSCAN, 0xFFFF);
+  }
+  for (;;)
+  {
     keys = keyscan_all(state);
-  while (keys == 0); /* Up press */
+    if (keys != 0)
+      break; /* Up press */
+    state->speccy->sleep(state->speccy, sleeptype_KEYSCAN, 0xFFFF);
+  }
 
   /* Reset the game, or send the hero to solitary. */
   if (itemflags == 0xFF || itemflags >= escapeitem_UNIFORM)
@@ -3677,7 +3913,7 @@ uint8_t keyscan_all(tgestate_t *state)
   port = port_KEYBOARD_SHIFTZXCV;
   do
   {
-    keys = state->speccy->in(state->speccy, port);
+    keys = zxinput_read(&state->speccy->input, port);
 
     /* Invert bits and mask off key bits. */
     keys = ~keys & 0x1F;
@@ -3752,31 +3988,79 @@ const screenlocstring_t *screenlocstring_plot(tgestate_t              *state,
   uint8_t    *screen; /* was DE */
   int         length; /* was B */
   const char *string; /* was HL */
+  textstrip_t strip;  /* Conv: Added */
 
   assert(state    != NULL);
   assert(slstring != NULL);
 
-  screen = &state->speccy->screen[slstring->screenloc];
+  screen = screen_address(state, slstring->screenloc);
   length = slstring->length;
   string = slstring->string;
-  do
-    screen = plot_glyph(string++, screen);
-  while (--length);
+
+  /* Conv: Render the whole string then copy it a scanline at a time, rather
+   * than plotting it a glyph at a time. */
+  render_text_strip(string, length, &strip);
+  (void) plot_text_strip(state, &strip, 0, length, screen);
+
+  /* Conv: The string may have been plotted over the game window. */
+  invalidate_game_window(state);
 
   return slstring + 1;
 }
 
 /* ----------------------------------------------------------------------- */
 
+/* Conv: Forward references for the renderer bodies below, which are
+ * expanded into each renderer. */
+static ALWAYS_INLINE void plot_horizontal_tiles_common(tgestate_t       *state,
+                                                       tileindex_t      *vistiles,
+                                                       supertileindex_t *maptiles,
+                                                       uint8_t           y,
+                                                       uint8_t          *window,
+                                                       int               columns,
+                                                       int               rows);
+static ALWAYS_INLINE void plot_vertical_tiles_common(tgestate_t       *state,
+                                                     tileindex_t      *vistiles,
+                                                     supertileindex_t *maptiles,
+                                                     uint8_t           x,
+                                                     uint8_t          *window,
+                                                     int               columns,
+                                                     int               rows,
+                                                     int               st_columns);
+static ALWAYS_INLINE uint8_t *plot_tile_then_advance(tgestate_t             *state,
+                                                     tileindex_t             tile_index,
+                                                     const supertileindex_t *psupertileindex,
+                                                     uint8_t                *scr,
+                                                     int                     columns,
+                                                     int                     rows);
+static ALWAYS_INLINE uint8_t *plot_tile(tgestate_t             *state,
+                                        tileindex_t             tile_index,
+                                        const supertileindex_t *psupertileindex,
+                                        uint8_t                *scr,
+                                        int                     columns,
+                                        int                     rows);
+static ALWAYS_INLINE void mark_window_buf_dirty_common(tgestate_t    *state,
+                                                       const uint8_t *p,
+                                                       int            width,
+                                                       int            height,
+                                                       int            columns,
+                                                       int            rows);
+
 /**
  * $A7C9: Get supertiles.
  *
  * Uses state->map_position to copy supertile indices from map into
  * the buffer at state->map_buf.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of get_supertiles for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void get_supertiles(tgestate_t *state)
+static ALWAYS_INLINE void get_supertiles_common(tgestate_t *state,
+                                                int         st_columns,
+                                                int         st_rows)
 {
   uint8_t                 v;     /* was A */
   const supertileindex_t *tiles; /* was HL */
@@ -3789,23 +4073,23 @@ void get_supertiles(tgestate_t *state)
   v = state->map_position.y & ~3; /* = 0, 4, 8, 12, ... */
 
   /* Multiply A by 13.5. (v is a multiple of 4, so this goes 0, 54, 108, 162, ...) */
-  tiles = &map[0] - MAPX + (v + (v >> 1)) * 9; // Subtract MAPX so it skips the first row.
+  tiles = &assets->map[0] - MAPX + (v + (v >> 1)) * 9; // Subtract MAPX so it skips the first row.
 
   /* Add horizontal offset. */
   tiles += state->map_position.x >> 2;
 
   /* Populate map_buf with 7x5 array of supertile refs. */
-  iters = state->st_rows;
+  iters = st_rows;
   buf = &state->map_buf[0];
   do
   {
     // ASSERT_MAP_PTR_VALID(tiles);
-    if (tiles >= &map[0] && (tiles + state->st_columns) < &map[MAPX * MAPY]) // conv: debugging
-      memcpy(buf, tiles, state->st_columns);
+    if (tiles >= &assets->map[0] && (tiles + st_columns) < &assets->map[MAPX * MAPY]) // conv: debugging
+      memcpy(buf, tiles, st_columns);
     else
-      memset(buf, 0x2a, state->st_columns); // debug
+      memset(buf, 0x2a, st_columns); // debug
 
-    buf   += state->st_columns;
+    buf   += st_columns;
     tiles += MAPX;
   }
   while (--iters);
@@ -3816,9 +4100,17 @@ void get_supertiles(tgestate_t *state)
 /**
  * $A80A: Plot the complete bottommost row of tiles.
  *
- * \param[in] state Pointer to game state.
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void plot_bottommost_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_bottommost_tiles(tgestate_t *state,
+                                                int         columns,
+                                                int         rows,
+                                                int         st_columns,
+                                                int         st_rows)
 {
   tileindex_t      *vistiles; /* was DE */
   supertileindex_t *maptiles; /* was HL' */
@@ -3827,20 +4119,24 @@ void plot_bottommost_tiles(tgestate_t *state)
 
   assert(state != NULL);
 
-  vistiles = &state->tile_buf[24 * 16];       // $F278 = visible tiles array + 24 * 16
-  maptiles = &state->map_buf[28];             // $FF74
-  y        = state->map_position.y;           // map_position y
-  window   = &state->window_buf[24 * 16 * 8]; // $FE90
+  vistiles = &state->tile_buf[columns * (rows - 1)];       // $F278 = visible tiles array + 24 * 16
+  maptiles = &state->map_buf[st_columns * (st_rows - 1)];  // $FF74
+  y        = state->map_position.y;                        // map_position y
+  window   = &state->window_buf[columns * (rows - 1) * 8]; // $FE90
 
-  plot_horizontal_tiles_common(state, vistiles, maptiles, y, window);
+  plot_horizontal_tiles_common(state, vistiles, maptiles, y, window, columns, rows);
 }
 
 /**
  * $A819: Plot the complete topmost row of tiles.
  *
- * \param[in] state Pointer to game state.
+ * \param[in] state   Pointer to game state.
+ * \param[in] columns Columns in the window. (Conv: added)
+ * \param[in] rows    Rows in the window. (Conv: added)
  */
-void plot_topmost_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_topmost_tiles(tgestate_t *state,
+                                             int         columns,
+                                             int         rows)
 {
   tileindex_t      *vistiles; /* was DE */
   supertileindex_t *maptiles; /* was HL' */
@@ -3854,7 +4150,7 @@ void plot_topmost_tiles(tgestate_t *state)
   y        = state->map_position.y; // map_position y
   window   = &state->window_buf[0]; // $F290
 
-  plot_horizontal_tiles_common(state, vistiles, maptiles, y, window);
+  plot_horizontal_tiles_common(state, vistiles, maptiles, y, window, columns, rows);
 }
 
 /**
@@ -3865,12 +4161,16 @@ void plot_topmost_tiles(tgestate_t *state)
  * \param[in] maptiles Pointer to 7x5 supertile refs.          (was HL')
  * \param[in] y        Map position y.                         (was A)
  * \param[in] window   Pointer to screen buffer start address. (was DE')
+ * \param[in] columns  Columns in the window. (Conv: added)
+ * \param[in] rows     Rows in the window. (Conv: added)
  */
-void plot_horizontal_tiles_common(tgestate_t       *state,
-                                  tileindex_t      *vistiles,
-                                  supertileindex_t *maptiles,
-                                  uint8_t           y,
-                                  uint8_t          *window)
+static ALWAYS_INLINE void plot_horizontal_tiles_common(tgestate_t       *state,
+                                                       tileindex_t      *vistiles,
+                                                       supertileindex_t *maptiles,
+                                                       uint8_t           y,
+                                                       uint8_t          *window,
+                                                       int               columns,
+                                                       int               rows)
 {
   // Conv: self_A86A removed. Can be replaced with pos_copy.
 
@@ -3893,8 +4193,8 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
   /* Initial edge. */
 
   assert(*maptiles < supertileindex__LIMIT);
-  tiles = &supertiles[*maptiles].tiles[offset];
-  A = tiles - &supertiles[0].tiles[0]; // Conv: Original code could simply use L.
+  tiles = &assets->supertiles[*maptiles].tiles[offset];
+  A = tiles - &assets->supertiles[0].tiles[0]; // Conv: Original code could simply use L.
 
   // 0,1,2,3 => 4,3,2,1
   A = -A & 3;
@@ -3911,7 +4211,7 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
 
     // Conv: Fused accesses and increments.
     t = *vistiles++ = *tiles++; // A = tile index
-    plot_tile(state, t, maptiles, window);
+    plot_tile(state, t, maptiles, window, columns, rows);
   }
   while (--iters);
 
@@ -3924,7 +4224,7 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
   {
     ASSERT_MAP_BUF_PTR_VALID(maptiles);
     assert(*maptiles < supertileindex__LIMIT);
-    tiles = &supertiles[*maptiles].tiles[y_offset]; // self modified by $A82A
+    tiles = &assets->supertiles[*maptiles].tiles[y_offset]; // self modified by $A82A
 
     iters = 4;
     do
@@ -3935,7 +4235,7 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
       ASSERT_SUPERTILE_PTR_VALID(tiles);
 
       t = *vistiles++ = *tiles++; // A = tile index
-      plot_tile(state, t, maptiles, window);
+      plot_tile(state, t, maptiles, window, columns, rows);
     }
     while (--iters);
 
@@ -3949,7 +4249,7 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
 
   ASSERT_MAP_BUF_PTR_VALID(maptiles);
   assert(*maptiles < supertileindex__LIMIT);
-  tiles = &supertiles[*maptiles].tiles[y_offset]; // read of self modified instruction
+  tiles = &assets->supertiles[*maptiles].tiles[y_offset]; // read of self modified instruction
   // Conv: A was A'.
   A = state->map_position.x & 3; // map_position lo (repeats earlier work)
   if (A == 0)
@@ -3964,7 +4264,7 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
     ASSERT_SUPERTILE_PTR_VALID(tiles);
 
     t = *vistiles++ = *tiles++; // Adash = tile index
-    plot_tile(state, t, maptiles, window);
+    plot_tile(state, t, maptiles, window, columns, rows);
   }
   while (--iters);
 }
@@ -3976,9 +4276,17 @@ void plot_horizontal_tiles_common(tgestate_t       *state,
  *
  * Called by pick_up_item and reset_outdoors.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of plot_all_tiles for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
  */
-void plot_all_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_all_tiles_common(tgestate_t *state,
+                                                int         columns,
+                                                int         rows,
+                                                int         st_columns)
 {
   tileindex_t      *vistiles; /* was DE */
   supertileindex_t *maptiles; /* was HL' */
@@ -3994,12 +4302,12 @@ void plot_all_tiles(tgestate_t *state)
   window   = &state->window_buf[0]; /* screen buffer start address */
   x        = state->map_position.x; /* map_position x */
 
-  iters = state->columns; /* Conv: was 24 */
+  iters = columns; /* Conv: was 24 */
   do
   {
     uint8_t newpos; /* was C' */
 
-    plot_vertical_tiles_common(state, vistiles, maptiles, x, window);
+    plot_vertical_tiles_common(state, vistiles, maptiles, x, window, columns, rows, st_columns);
     vistiles++;
 
     newpos = ++x;
@@ -4014,9 +4322,15 @@ void plot_all_tiles(tgestate_t *state)
 /**
  * $A8CF: Plot the complete rightmost column of tiles.
  *
- * \param[in] state Pointer to game state.
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
  */
-void plot_rightmost_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_rightmost_tiles(tgestate_t *state,
+                                               int         columns,
+                                               int         rows,
+                                               int         st_columns)
 {
   tileindex_t      *vistiles; /* was DE */
   supertileindex_t *maptiles; /* was HL' */
@@ -4025,9 +4339,9 @@ void plot_rightmost_tiles(tgestate_t *state)
 
   assert(state != NULL);
 
-  vistiles = &state->tile_buf[23];   /* visible tiles array */
-  maptiles = &state->map_buf[6];     /* 7x5 supertile refs */
-  window   = &state->window_buf[23]; /* screen buffer start address */
+  vistiles = &state->tile_buf[columns - 1];    /* visible tiles array */
+  maptiles = &state->map_buf[st_columns - 1];  /* 7x5 supertile refs */
+  window   = &state->window_buf[columns - 1];  /* screen buffer start address */
   x        = state->map_position.x;  /* map_position x */
 
   x &= 3;
@@ -4035,15 +4349,21 @@ void plot_rightmost_tiles(tgestate_t *state)
     maptiles--;
   x = state->map_position.x - 1; /* map_position x */
 
-  plot_vertical_tiles_common(state, vistiles, maptiles, x, window);
+  plot_vertical_tiles_common(state, vistiles, maptiles, x, window, columns, rows, st_columns);
 }
 
 /**
  * $A8E7: Plot the complete leftmost column of tiles.
  *
- * \param[in] state Pointer to game state.
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
  */
-void plot_leftmost_tiles(tgestate_t *state)
+static ALWAYS_INLINE void plot_leftmost_tiles(tgestate_t *state,
+                                              int         columns,
+                                              int         rows,
+                                              int         st_columns)
 {
   tileindex_t      *vistiles; /* was DE */
   supertileindex_t *maptiles; /* was HL' */
@@ -4057,7 +4377,7 @@ void plot_leftmost_tiles(tgestate_t *state)
   window   = &state->window_buf[0]; /* screen buffer start address */
   x        = state->map_position.x; /* map_position x */
 
-  plot_vertical_tiles_common(state, vistiles, maptiles, x, window);
+  plot_vertical_tiles_common(state, vistiles, maptiles, x, window, columns, rows, st_columns);
 }
 
 /**
@@ -4068,12 +4388,18 @@ void plot_leftmost_tiles(tgestate_t *state)
  * \param[in] maptiles Pointer to 7x5 supertile refs.          (was HL')
  * \param[in] x        Map position x.                         (was A)
  * \param[in] window   Pointer to screen buffer start address. (was DE')
- */
-void plot_vertical_tiles_common(tgestate_t       *state,
-                                tileindex_t      *vistiles,
-                                supertileindex_t *maptiles,
-                                uint8_t           x,
-                                uint8_t          *window)
+ * \param[in] columns  Columns in the window. (Conv: added)
+ * \param[in] rows     Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ */
+static ALWAYS_INLINE void plot_vertical_tiles_common(tgestate_t       *state,
+                                                     tileindex_t      *vistiles,
+                                                     supertileindex_t *maptiles,
+                                                     uint8_t           x,
+                                                     uint8_t          *window,
+                                                     int               columns,
+                                                     int               rows,
+                                                     int               st_columns)
 {
   /* Conv: self_A94D removed. */
 
@@ -4096,7 +4422,7 @@ void plot_vertical_tiles_common(tgestate_t       *state,
   /* Initial edge. */
 
   assert(*maptiles < supertileindex__LIMIT);
-  tiles = &supertiles[*maptiles].tiles[offset];
+  tiles = &assets->supertiles[*maptiles].tiles[offset];
 
   // 0,1,2,3 => 4,3,2,1
   iters = -((offset >> 2) & 3) & 3;
@@ -4111,13 +4437,13 @@ void plot_vertical_tiles_common(tgestate_t       *state,
     ASSERT_SUPERTILE_PTR_VALID(tiles);
 
     t = *vistiles = *tiles; // A = tile index
-    plot_tile_then_advance(state, t, tiles, window);
+    plot_tile_then_advance(state, t, tiles, window, columns, rows);
     vistiles += 4; // stride
-    tiles += state->columns - 1;
+    tiles += columns - 1;
   }
   while (--iters);
 
-  maptiles += 7; // move to next row
+  maptiles += st_columns; // move to next row
 
   /* Middle loop. */
 
@@ -4126,7 +4452,7 @@ void plot_vertical_tiles_common(tgestate_t       *state,
   {
     ASSERT_MAP_BUF_PTR_VALID(maptiles);
     assert(*maptiles < supertileindex__LIMIT);
-    tiles = &supertiles[*maptiles].tiles[x_offset]; // self modified by $A8F6
+    tiles = &assets->supertiles[*maptiles].tiles[x_offset]; // self modified by $A8F6
 
     iters = 4;
     do
@@ -4137,13 +4463,13 @@ void plot_vertical_tiles_common(tgestate_t       *state,
       ASSERT_SUPERTILE_PTR_VALID(tiles);
 
       t = *vistiles = *tiles; // A = tile index
-      plot_tile_then_advance(state, t, tiles, window);
-      tiles += state->columns - 1;
+      plot_tile_then_advance(state, t, tiles, window, columns, rows);
+      tiles += columns - 1;
       vistiles += 4; // stride
     }
     while (--iters);
 
-    maptiles += 7; // move to next row
+    maptiles += st_columns; // move to next row
   }
   while (--iters2);
 
@@ -4151,7 +4477,7 @@ void plot_vertical_tiles_common(tgestate_t       *state,
 
   ASSERT_MAP_BUF_PTR_VALID(maptiles);
   assert(*maptiles < supertileindex__LIMIT);
-  tiles = &supertiles[*maptiles].tiles[x_offset]; // x_offset = read of self modified instruction
+  tiles = &assets->supertiles[*maptiles].tiles[x_offset]; // x_offset = read of self modified instruction
   iters = (state->map_position.y & 3) + 1;
   do
   {
@@ -4161,9 +4487,9 @@ void plot_vertical_tiles_common(tgestate_t       *state,
     ASSERT_SUPERTILE_PTR_VALID(tiles);
 
     t = *vistiles = *tiles; // A = tile index
-    plot_tile_then_advance(state, t, tiles, window);
+    plot_tile_then_advance(state, t, tiles, window, columns, rows);
     vistiles += 4; // stride
-    tiles += state->columns - 1;
+    tiles += columns - 1;
   }
   while (--iters);
 }
@@ -4178,17 +4504,21 @@ void plot_vertical_tiles_common(tgestate_t       *state,
  * \param[in] psupertileindex Pointer to supertile index (used to select the
  *                       correct exterior tile set). (was HL')
  * \param[in] scr        Address of output buffer start address. (was DE')
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
  *
  * \return Next output address. (was DE')
  */
-uint8_t *plot_tile_then_advance(tgestate_t             *state,
-                                tileindex_t             tile_index,
-                                const supertileindex_t *psupertileindex,
-                                uint8_t                *scr)
+static ALWAYS_INLINE uint8_t *plot_tile_then_advance(tgestate_t             *state,
+                                                     tileindex_t             tile_index,
+                                                     const supertileindex_t *psupertileindex,
+                                                     uint8_t                *scr,
+                                                     int                     columns,
+                                                     int                     rows)
 {
   assert(state != NULL);
 
-  return plot_tile(state, tile_index, psupertileindex, scr) + (state->columns + 1) * 8 - 1; // -1 compensates the +1 in plot_tile
+  return plot_tile(state, tile_index, psupertileindex, scr, columns, rows) + (columns + 1) * 8 - 1; // -1 compensates the +1 in plot_tile
 }
 
 /* ----------------------------------------------------------------------- */
@@ -4203,19 +4533,22 @@ uint8_t *plot_tile_then_advance(tgestate_t             *state,
  * \param[in] psupertileindex Pointer to supertile index (used to select the
                          correct exterior tile set). (was HL')
  * \param[in] scr        Output buffer start address. (was DE')
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
  *
  * \return Next output address. (was DE')
  */
-uint8_t *plot_tile(tgestate_t             *state,
-                   tileindex_t             tile_index,
-                   const supertileindex_t *psupertileindex,
-                   uint8_t                *scr)
+static ALWAYS_INLINE uint8_t *plot_tile(tgestate_t             *state,
+                                        tileindex_t             tile_index,
+                                        const supertileindex_t *psupertileindex,
+                                        uint8_t                *scr,
+                                        int                     columns,
+                                        int                     rows)
 {
   supertileindex_t  supertileindex; /* was A' */
   const tile_t     *tileset;        /* was BC' */
   const tilerow_t  *src;            /* was DE' */
   uint8_t          *dst;            /* was HL' */
-  uint8_t           iters;          /* was A */
 
   assert(state           != NULL);
   //assert(tile_index < 220); // ideally the constant should be elsewhere
@@ -4226,75 +4559,115 @@ uint8_t *plot_tile(tgestate_t             *state,
   assert(supertileindex < supertileindex__LIMIT);
 
   if (supertileindex < 45)
-    tileset = &exterior_tiles_1[0];
+    tileset = &assets->exterior_tiles[0][0];
   else if (supertileindex < 139 || supertileindex >= 204)
-    tileset = &exterior_tiles_2[0];
+    tileset = &assets->exterior_tiles[1][0];
   else
-    tileset = &exterior_tiles_3[0];
+    tileset = &assets->exterior_tiles[2][0];
 
+  /* Conv: Unrolled. The stride is an immediate in the fixed size renderer. */
   src = &tileset[tile_index].row[0];
   dst = scr;
-  iters = 8;
-  do
-  {
-    *dst = *src++;
-    dst += state->columns; /* stride */ // FUTURE: Hoist.
-  }
-  while (--iters);
+  dst[0 * columns] = src[0];
+  dst[1 * columns] = src[1];
+  dst[2 * columns] = src[2];
+  dst[3 * columns] = src[3];
+  dst[4 * columns] = src[4];
+  dst[5 * columns] = src[5];
+  dst[6 * columns] = src[6];
+  dst[7 * columns] = src[7];
+
+  mark_window_buf_dirty_common(state, scr, 1, 8, columns, rows);
 
   return scr + 1;
 }
 
 /* ----------------------------------------------------------------------- */
 
-// Fixed constants for now.
-#define tile_buf_length      (24 * 17)
-#define window_buf_length (24 * 8 * 17)
+/* Conv: Lengths of the buffers given the window's dimensions. */
+#define tile_buf_length   (columns * rows)
+#define window_buf_length (columns * 8 * rows)
 
 /**
  * $A9E4: Shunt the map left.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_left for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_left(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_left_common(tgestate_t *state,
+                                                int         columns,
+                                                int         rows,
+                                                int         st_columns,
+                                                int         st_rows)
 {
   assert(state != NULL);
 
   state->map_position.x++;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
   memmove(&state->tile_buf[0], &state->tile_buf[1], tile_buf_length - 1);
   memmove(&state->window_buf[0], &state->window_buf[1], window_buf_length - 1);
+  invalidate_game_window(state);
 
-  plot_rightmost_tiles(state);
+  plot_rightmost_tiles(state, columns, rows, st_columns);
 }
 
 /**
  * $AA05: Shunt the map right.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_right for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_right(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_right_common(tgestate_t *state,
+                                                 int         columns,
+                                                 int         rows,
+                                                 int         st_columns,
+                                                 int         st_rows)
 {
   assert(state != NULL);
 
   state->map_position.x--;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
   memmove(&state->tile_buf[1], &state->tile_buf[0], tile_buf_length - 1);
   memmove(&state->window_buf[1], &state->window_buf[0], window_buf_length);
+  invalidate_game_window(state);
 
-  plot_leftmost_tiles(state);
+  plot_leftmost_tiles(state, columns, rows, st_columns);
 }
 
 /**
  * $AA26: Shunt the map up-right.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_up_right for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_up_right(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_up_right_common(tgestate_t *state,
+                                                    int         columns,
+                                                    int         rows,
+                                                    int         st_columns,
+                                                    int         st_rows)
 {
   assert(state != NULL);
 
@@ -4303,76 +4676,123 @@ void shunt_map_up_right(tgestate_t *state)
   state->map_position.x--;
   state->map_position.y++;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
-  memmove(&state->tile_buf[1], &state->tile_buf[24], tile_buf_length - 24);
-  memmove(&state->window_buf[1], &state->window_buf[24 * 8], window_buf_length - 24 * 8);
+  memmove(&state->tile_buf[1], &state->tile_buf[columns], tile_buf_length - columns);
+  memmove(&state->window_buf[1], &state->window_buf[columns * 8], window_buf_length - columns * 8);
+  invalidate_game_window(state);
 
-  plot_bottommost_tiles(state);
-  plot_leftmost_tiles(state);
+  plot_bottommost_tiles(state, columns, rows, st_columns, st_rows);
+  plot_leftmost_tiles(state, columns, rows, st_columns);
 }
 
 /**
  * $AA4B: Shunt the map up.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_up for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_up(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_up_common(tgestate_t *state,
+                                              int         columns,
+                                              int         rows,
+                                              int         st_columns,
+                                              int         st_rows)
 {
   assert(state != NULL);
 
   state->map_position.y++;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
-  memmove(&state->tile_buf[0], &state->tile_buf[24], tile_buf_length - 24);
-  memmove(&state->window_buf[0], &state->window_buf[24 * 8], window_buf_length - 24 * 8);
+  memmove(&state->tile_buf[0], &state->tile_buf[columns], tile_buf_length - columns);
+  memmove(&state->window_buf[0], &state->window_buf[columns * 8], window_buf_length - columns * 8);
+  invalidate_game_window(state);
 
-  plot_bottommost_tiles(state);
+  plot_bottommost_tiles(state, columns, rows, st_columns, st_rows);
 }
 
 /**
  * $AA6C: Shunt the map down.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_down for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_down(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_down_common(tgestate_t *state,
+                                                int         columns,
+                                                int         rows,
+                                                int         st_columns,
+                                                int         st_rows)
 {
   assert(state != NULL);
 
   state->map_position.y--;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
-  memmove(&state->tile_buf[24], &state->tile_buf[0], tile_buf_length - 24);
-  memmove(&state->window_buf[24 * 8], &state->window_buf[0], window_buf_length - 24 * 8);
+  memmove(&state->tile_buf[columns], &state->tile_buf[0], tile_buf_length - columns);
+  memmove(&state->window_buf[columns * 8], &state->window_buf[0], window_buf_length - columns * 8);
+  invalidate_game_window(state);
 
-  plot_topmost_tiles(state);
+  plot_topmost_tiles(state, columns, rows);
 }
 
 /**
  * $AA8D: Shunt the map down left.
  *
- * \param[in] state Pointer to game state.
+ * Conv: The body of shunt_map_down_left for each renderer.
+ *
+ * \param[in] state      Pointer to game state.
+ * \param[in] columns    Columns in the window. (Conv: added)
+ * \param[in] rows       Rows in the window. (Conv: added)
+ * \param[in] st_columns Supertile columns in map_buf. (Conv: added)
+ * \param[in] st_rows    Supertile rows in map_buf. (Conv: added)
  */
-void shunt_map_down_left(tgestate_t *state)
+static ALWAYS_INLINE void shunt_map_down_left_common(tgestate_t *state,
+                                                     int         columns,
+                                                     int         rows,
+                                                     int         st_columns,
+                                                     int         st_rows)
 {
   assert(state != NULL);
 
   state->map_position.x++;
   state->map_position.y--;
 
-  get_supertiles(state);
+  get_supertiles_common(state, st_columns, st_rows);
+  if (!state->rendering)
+    return; /* Conv: The window is repainted when rendering resumes. */
 
-  memmove(&state->tile_buf[24], &state->tile_buf[1], tile_buf_length - 24 - 1);
-  memmove(&state->window_buf[24 * 8], &state->window_buf[1], window_buf_length - 24 * 8 - 1);
+  memmove(&state->tile_buf[columns], &state->tile_buf[1], tile_buf_length - columns - 1);
+  memmove(&state->window_buf[columns * 8], &state->window_buf[1], window_buf_length - columns * 8 - 1);
+  invalidate_game_window(state);
 
-  plot_topmost_tiles(state);
-  plot_rightmost_tiles(state);
+  plot_topmost_tiles(state, columns, rows);
+  plot_rightmost_tiles(state, columns, rows, st_columns);
 }
 
 /* ----------------------------------------------------------------------- */
 
+#undef window_buf_length
+#undef tile_buf_length
+
+/* ----------------------------------------------------------------------- */
+
 /**
  * $AAB2: Moves the map when the hero walks.
  *
@@ -4630,7 +5050,7 @@ attribute_t choose_game_window_attributes(tgestate_t *state)
     }
   }
 
-  state->game_window_attribute = attr;
+  state->cold.game_window_attribute = attr;
 
   return attr;
 }
@@ -4640,13 +5060,16 @@ attribute_t choose_game_window_attributes(tgestate_t *state)
 /**
  * $ABA0: Zoombox.
  *
+ * Conv: The original opens the zoombox before returning, presenting each
+ * step. Here the zoombox is only started. tge_main then opens it a step per
+ * frame, pausing the game meanwhile just as the original did. Callers which
+ * draw over the game window next use zoombox_open to finish it first.
+ *
  * \param[in] state Pointer to game state.
  */
 void zoombox(tgestate_t *state)
 {
   attribute_t attrs; /* was A */
-  uint8_t    *pvar;  /* was HL */
-  uint8_t     var;   /* was A */
 
   assert(state != NULL);
 
@@ -4655,15 +5078,34 @@ void zoombox(tgestate_t *state)
 
   attrs = choose_game_window_attributes(state);
 
-  state->speccy->attributes[ 9 * state->width + 18] = attrs;
-  state->speccy->attributes[ 9 * state->width + 19] = attrs;
-  state->speccy->attributes[10 * state->width + 18] = attrs;
-  state->speccy->attributes[10 * state->width + 19] = attrs;
+  state->speccy->attributes[ 9 * state->cold.width + 18] = attrs;
+  state->speccy->attributes[ 9 * state->cold.width + 19] = attrs;
+  state->speccy->attributes[10 * state->cold.width + 18] = attrs;
+  state->speccy->attributes[10 * state->cold.width + 19] = attrs;
 
   state->zoombox.width  = 0;
   state->zoombox.height = 0;
 
-  do
+  state->zoombox.opening = 1;
+  if (state->cold.skip_transitions)
+    zoombox_open(state);
+}
+
+/**
+ * Conv: Grow the zoombox by one step and draw it. Split out from zoombox.
+ *
+ * \param[in] state Pointer to game state.
+ *
+ * \return Non-zero while the zoombox is still opening.
+ */
+int zoombox_step(tgestate_t *state)
+{
+  uint8_t *pvar; /* was HL */
+  uint8_t  var;  /* was A */
+
+  assert(state != NULL);
+  assert(state->zoombox.opening);
+
   {
     pvar = &state->zoombox.x;
     var = *pvar;
@@ -4674,7 +5116,7 @@ void zoombox(tgestate_t *state)
       pvar[1]++;
     }
 
-    pvar++; // &state->width;
+    pvar++; // &state->zoombox.width;
     var += *pvar;
     if (var < 22)
       (*pvar)++;
@@ -4688,17 +5130,42 @@ void zoombox(tgestate_t *state)
       pvar[1]++;
     }
 
-    pvar++; // &state->height;
+    pvar++; // &state->zoombox.height;
     var += *pvar;
     if (var < 15)
       (*pvar)++;
 
     zoombox_fill(state);
     zoombox_draw_border(state);
+  }
+
+  if (state->zoombox.height + state->zoombox.width < 35)
+    return 1;
+
+  state->zoombox.opening = 0;
+
+  /* Conv: The zoombox drew straight to the screen. */
+  invalidate_game_window(state);
+
+  return 0;
+}
+
+/**
+ * Conv: Open the zoombox fully before returning. Each step is presented
+ * unless transitions are skipped.
+ *
+ * \param[in] state Pointer to game state.
+ */
+void zoombox_open(tgestate_t *state)
+{
+  assert(state != NULL);
 
-    state->speccy->kick(state->speccy);
+  while (state->zoombox.opening)
+  {
+    (void) zoombox_step(state);
+    if (!state->cold.skip_transitions)
+      state->speccy->kick(state->speccy); /* mid-frame: present only */
   }
-  while (state->zoombox.height + state->zoombox.width < 35);
 }
 
 /**
@@ -4721,7 +5188,6 @@ void zoombox_fill(tgestate_t *state)
   uint8_t  *dst;        /* was DE */
   uint16_t  offset;     /* was HL */
   uint8_t  *src;        /* was HL */
-  uint16_t  dst_stride; /* was BC */
   uint8_t  *prev_dst;   /* was stack */
 
   /* Conv: Simplified calculation to use a single multiply. */
@@ -4750,20 +5216,14 @@ void zoombox_fill(tgestate_t *state)
       dst += hz_count2; // this is LDIR post-increment. it can be removed along with the line below.
       src += hz_count2 + src_skip; // move to next source line
       dst -= hz_count1; // was E -= self_AC55; // undo LDIR postinc
-      dst += state->width * 8; // was D++; // move to next scanline
+      dst += state->cell_scanline_stride; // was D++; // move to next scanline
 
       if (iters2 > 1 || iters > 1)
         ASSERT_SCREEN_PTR_VALID(dst);
     }
     while (--iters2);
 
-    dst = prev_dst;
-
-    dst_stride = state->width; // scanline-to-scanline stride (32)
-    if (((dst - screen_base) & 0xFF) >= 224) // 224+32 == 256, so do skip to next band // TODO: 224 should be (256 - state->width)
-      dst_stride += 7 << 8; // was B = 7
-
-    dst += dst_stride;
+    dst = get_next_char_row(state, prev_dst); // Conv: Was inline.
   }
   while (--iters);
 }
@@ -4781,7 +5241,6 @@ void zoombox_draw_border(tgestate_t *state)
 
   uint8_t *addr;  /* was HL */
   uint8_t  iters; /* was B */
-  int      delta; /* was DE */
 
   addr = screen_base + state->game_window_start_offsets[(state->zoombox.y - 1) * 8]; // Conv: Screen base hoisted from table.
   ASSERT_SCREEN_PTR_VALID(addr);
@@ -4798,20 +5257,14 @@ void zoombox_draw_border(tgestate_t *state)
 
   /* Top right */
   zoombox_draw_tile(state, zoombox_tile_TR, addr);
-  delta = state->width; // move to next character row
-  if (((addr - screen_base) & 0xFF) >= 224) // was: if (L >= 224) // if adding 32 would overflow
-    delta += 0x0700; // was D=7
-  addr += delta;
+  addr = get_next_char_row(state, addr); // Conv: Was inline.
 
   /* Vertical, moving down */
   iters = state->zoombox.height;
   do
   {
     zoombox_draw_tile(state, zoombox_tile_VT, addr);
-    delta = state->width; // move to next character row
-    if (((addr - screen_base) & 0xFF) >= 224) // was: if (L >= 224) // if adding 32 would overflow
-      delta += 0x0700; // was D=7
-    addr += delta;
+    addr = get_next_char_row(state, addr); // Conv: Was inline.
   }
   while (--iters);
 
@@ -4826,20 +5279,14 @@ void zoombox_draw_border(tgestate_t *state)
 
   /* Bottom left */
   zoombox_draw_tile(state, zoombox_tile_BL, addr);
-  delta = -state->width; // move to next character row
-  if (((addr - screen_base) & 0xFF) < 32) // was: if (L < 32) // if subtracting 32 would underflow
-    delta -= 0x0700;
-  addr += delta;
+  addr = get_prev_char_row(state, addr); // Conv: Was inline.
 
   /* Vertical, moving up */
   iters = state->zoombox.height;
   do
   {
     zoombox_draw_tile(state, zoombox_tile_VT, addr);
-    delta = -state->width; // move to next character row
-    if (((addr - screen_base) & 0xFF) < 32) // was: if (L < 32) // if subtracting 32 would underflow
-      delta -= 0x0700;
-    addr += delta;
+    addr = get_prev_char_row(state, addr); // Conv: Was inline.
   }
   while (--iters);
 }
@@ -4871,7 +5318,6 @@ void zoombox_draw_tile(tgestate_t     *state,
   uint8_t         *addr;  /* was DE */
   const tilerow_t *row;   /* was HL */
   uint8_t          iters; /* was B */
-  ptrdiff_t        off;   /* Conv: new */
   attribute_t     *attrs; /* was HL */
 
   assert(state != NULL);
@@ -4884,27 +5330,15 @@ void zoombox_draw_tile(tgestate_t     *state,
   do
   {
     *addr = *row++;
-    addr += 256;
+    addr += state->cell_scanline_stride;
   }
   while (--iters);
 
   /* Conv: The original game can munge bytes directly here, assuming screen
    * addresses, but I can't... */
 
-  addr -= 256; /* Compensate for overshoot */
-  off = addr - &state->speccy->screen[0];
-
-  attrs = &state->speccy->attributes[off & 0xFF]; // to within a third
-
-  // can i do ((off >> 11) << 8) ?
-  if (off >= 0x0800)
-  {
-    attrs += 256;
-    if (off >= 0x1000)
-      attrs += 256;
-  }
-
-  *attrs = state->game_window_attribute;
+  attrs = screen_attribute_address(state, addr_in);
+  *attrs = state->cold.game_window_attribute;
 }
 
 /* ----------------------------------------------------------------------- */
@@ -5126,7 +5560,7 @@ void nighttime(tgestate_t *state)
       row    = (int16_t) ((H << 8) | L);
 
       // HL must be row, BC must be column
-      attrs = &state->speccy->attributes[0x46 + row * state->width + column]; // 0x46 = address of top-left game window attribute
+      attrs = &state->speccy->attributes[0x46 + row * state->cold.width + column]; // 0x46 = address of top-left game window attribute
     }
 
     state->searchlight.use_full_window = use_full_window;
@@ -5182,155 +5616,155 @@ void searchlight_caught(tgestate_t                   *state,
   decrease_morale(state, 10); // exit via
 }
 
+/**
+ * $AF3E: Searchlight circle shape.
+ *
+ * Conv: The original is a 16x16 one-bit-per-pixel bitmap which the plotter
+ * shifts out bit by bit. Here each bit is expanded into a whole byte mask
+ * (0xFF where lit) so that a row of attributes can be blended in one go.
+ */
+#define SL_BIT(v, n) ((((v) >> (n)) & 1) ? 0xFF : 0x00)
+#define SL_BYTE(v)   SL_BIT(v, 7), SL_BIT(v, 6), SL_BIT(v, 5), SL_BIT(v, 4), \
+                     SL_BIT(v, 3), SL_BIT(v, 2), SL_BIT(v, 1), SL_BIT(v, 0)
+#define SL_ROW(a, b) { SL_BYTE(a), SL_BYTE(b) }
+
+static const uint8_t searchlight_shape[16][16] =
+{
+  SL_ROW(0x00, 0x00),
+  SL_ROW(0x00, 0x00),
+  SL_ROW(0x00, 0x00),
+  SL_ROW(0x01, 0x80),
+  SL_ROW(0x07, 0xE0),
+  SL_ROW(0x0F, 0xF0),
+  SL_ROW(0x0F, 0xF0),
+  SL_ROW(0x1F, 0xF8),
+  SL_ROW(0x1F, 0xF8),
+  SL_ROW(0x0F, 0xF0),
+  SL_ROW(0x0F, 0xF0),
+  SL_ROW(0x07, 0xE0),
+  SL_ROW(0x01, 0x80),
+  SL_ROW(0x00, 0x00),
+  SL_ROW(0x00, 0x00),
+  SL_ROW(0x00, 0x00),
+};
+
+#undef SL_ROW
+#undef SL_BYTE
+#undef SL_BIT
+
+/**
+ * Searchlight horizontal clip masks, indexed by attribute column plus shape
+ * column. A row starting at column x is clipped by the 16 bytes at [x].
+ *
+ * Conv: These encode the original's per-pixel column tests. When clipped
+ * to the left side of the window, columns 7..21 are plotted and a row which
+ * runs off the right edge wraps into the following attribute row, as in the
+ * original. With the full window, columns 7..29 are plotted and the row
+ * stops at column 30.
+ */
+static const uint8_t searchlight_clip[2][32 + 16] =
+{
+  {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, /*  0.. 7 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /*  8..15 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, /* 16..23 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* 24..31 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, /* wrapped  0.. 7 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* wrapped  8..15 */
+  },
+  {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, /*  0.. 7 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /*  8..15 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* 16..23 */
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, /* 24..31 */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* stopped */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* stopped */
+  },
+};
+
+/** Replicates an attribute byte across a 64-bit word. */
+#define SL_SPLAT(attr) ((uint64_t) (attr) * UINT64_C(0x0101010101010101))
+
 /**
  * $AEB8: Searchlight plotter.
  *
+ * Conv: Rewritten to blend each 16-attribute row of the light as two
+ * 64-bit words: out = (clip & lit-or-unlit colour) | (~clip & old).
+ *
  * \param[in] state Pointer to game state.
  * \param[in] attrs Pointer to screen attributes. (was DE)
  */
 void searchlight_plot(tgestate_t *state, attribute_t *attrs)
 {
-  /**
-   * $AF3E: Searchlight circle shape.
-   */
-  static const uint8_t searchlight_shape[2 * 16] =
-  {
-    0x00, 0x00,
-    0x00, 0x00,
-    0x00, 0x00,
-    0x01, 0x80,
-    0x07, 0xE0,
-    0x0F, 0xF0,
-    0x0F, 0xF0,
-    0x1F, 0xF8,
-    0x1F, 0xF8,
-    0x0F, 0xF0,
-    0x0F, 0xF0,
-    0x07, 0xE0,
-    0x01, 0x80,
-    0x00, 0x00,
-    0x00, 0x00,
-    0x00, 0x00,
-  };
+  const uint64_t lit   = SL_SPLAT(attribute_YELLOW_OVER_BLACK);
+  const uint64_t unlit = SL_SPLAT(attribute_BRIGHT_BLUE_OVER_BLACK);
+
+  attribute_t   *attrs_base;      /* was $5800 */
+  ptrdiff_t      offset;          /* was DE */
+  int            use_full_window; /* was A */
+  int            row;             /* was C' */
 
   assert(state != NULL);
 
-  attribute_t *const attrs_base = &state->speccy->attributes[0];
+  attrs_base = &state->speccy->attributes[0];
   ASSERT_SCREEN_ATTRIBUTES_PTR_VALID(attrs_base);
 
-  const uint8_t *shape;       /* was DE' */
-  uint8_t        iters;       /* was C' */
-  uint8_t        use_full_window; /* was A */
-  attribute_t   *max_y_attrs; /* was HL */
-  attribute_t   *saved_attrs; /* was stack */
-  attribute_t   *pattrs2;     /* was HL */
-  uint8_t        iters2;      /* was B' */
-  int            carry = 0;
-
-  shape = &searchlight_shape[0];
-  iters = 16; /* height */
-  do
-  {
-    ptrdiff_t x; /* was A */
-
-    use_full_window = state->searchlight.use_full_window; // a clipping flag maybe?
-
-    /* Screen coords are x = 0..31, y = 0..23.
-     * Game window occupies attribute rows 2..17 and columns 7..29 (inclusive).
-     * Attribute row 18 is the row beyond the bottom edge of the game window. */
-
-    x = (attrs - attrs_base) & 31; // '& 31' -> '% state->width'  Conv: hoisted
-
-    // pattrs1 must be y limit
-    max_y_attrs = &attrs_base[32 * 18]; // was HL = 0x5A40; // screen attribute address (column 0 + bottom of game screen)
-    if (use_full_window)
-    {
-      // Conv: was: if ((E & 31) >= 22) L = 32;
-      // E & 31 => 4th to last row, or later
-      if (x >= 22) // 22 => 8 attrs away from the edge maybe?
-        max_y_attrs = &attrs_base[32 * 19]; // colors in bottom border
-    }
-    if (attrs >= max_y_attrs) // gone off the end of the game screen?
-      goto exit; // Conv: Original code just returned, goto exit instead so I can force a screen refresh down there.
-
-    saved_attrs = attrs; // PUSH DE
+  /* Screen coords are x = 0..31, y = 0..23.
+   * Game window occupies attribute rows 2..17 and columns 7..29 (inclusive).
+   * Attribute row 18 is the row beyond the bottom edge of the game window.
+   * The light's origin may lie above or left of the attributes, so work in
+   * signed offsets rather than pointers. */
+  offset          = attrs - attrs_base;
+  use_full_window = state->searchlight.use_full_window != 0;
+
+  for (row = 0; row < 16; row++, offset += state->cold.width)
+  {
+    ptrdiff_t      x;             /* was A */
+    ptrdiff_t      max_y_offset;  /* was HL */
+    ptrdiff_t      min_y_offset;  /* was HL */
+    const uint8_t *clip;
+    const uint8_t *shape;
+    int            half;
+
+    x = offset & 31; // '& 31' -> '% state->cold.width'
+
+    max_y_offset = 32 * 18;
+    if (use_full_window && x >= 22)
+      max_y_offset = 32 * 19; // colors in bottom border
+    if (offset >= max_y_offset) // gone off the end of the game screen?
+      break;
 
-    pattrs2 = &attrs_base[32 * 2]; // screen attribute address (row 2, column 0)
-    if (use_full_window)
-    {
-      // Conv: was: if (E & 31) >= 7) L = 32;
-      if (x >= 7)
-        pattrs2 = &attrs_base[32 * 1]; // (row 1, column 0) // seems responsible for colouring in the top border
-    }
-    if (attrs < pattrs2)
-    {
-      shape += 2;
-      goto next_row;
-    }
+    min_y_offset = 32 * 2;
+    if (use_full_window && x >= 7)
+      min_y_offset = 32 * 1; // colours in the top border
+    if (offset < min_y_offset)
+      continue;
 
-    iters2 = 2; /* iterations */ // bytes per row
-    do
+    clip  = &searchlight_clip[use_full_window][x];
+    shape = &searchlight_shape[row][0];
+    for (half = 0; half < 16; half += 8)
     {
-      uint8_t iters3; /* was B */
-      uint8_t pixels; /* was C */
-
-      pixels = *shape; // Conv: Original uses A as temporary.
-
-      iters3 = 8; /* iterations */ // bits per byte
-      do
-      {
-        x = (attrs - attrs_base) & 31; // Conv: was interleaved; '& 31's hoisted from below; '& 31' -> '% state->width' as above
-        if (!use_full_window)
-        {
-          if (x >= 22)
-            // don't render right of the game window
-            goto dont_plot;
-        }
-        else
-        {
-          if (x >= 30) // Conv: Constant 30 was in E
-          {
-            // don't render right of the game window
-            do
-              shape++;
-            while (--iters2);
-
-            goto next_row;
-          }
-        }
-
-        // plot
-        if (x < 7) // Conv: Constant 7 was in D
-        {
-          // don't render left of the game window
-        dont_plot:
-          RL(pixels); // no plot
-        }
-        else
-        {
-          RL(pixels);
-          if (carry)
-            *attrs = attribute_YELLOW_OVER_BLACK;
-          else
-            *attrs = attribute_BRIGHT_BLUE_OVER_BLACK;
-        }
-        attrs++;
-      }
-      while (--iters3);
-
-      shape++;
+      uint64_t m; /* clip mask */
+      uint64_t s; /* shape mask */
+      uint64_t v; /* attributes */
+
+      memcpy(&m, &clip[half], 8);
+      if (m == 0)
+        continue;
+      memcpy(&s, &shape[half], 8);
+      memcpy(&v, &attrs_base[offset + half], 8);
+      v = (m & ((s & lit) | (~s & unlit))) | (~m & v);
+      memcpy(&attrs_base[offset + half], &v, 8);
     }
-    while (--iters2);
-
-next_row:
-    attrs = saved_attrs + state->width;
   }
-  while (--iters);
 
-exit:
+  // Conv: The original code just returned at the bottom edge. We force a
+  // screen refresh.
   state->speccy->kick(state->speccy);
 }
 
+#undef SL_SPLAT
+
 /* ----------------------------------------------------------------------- */
 
 /**
@@ -5449,7 +5883,7 @@ int collision(tgestate_t *state, vischar_t *input_vischar)
       /* and current vischar is not the hero... */
       if (vischar != &state->vischars[0])
       {
-        if (state->bribed_character == input_vischar->character)
+        if (state->cold.bribed_character == input_vischar->character)
         {
           accept_bribe(state, input_vischar);
         }
@@ -5940,6 +6374,9 @@ void reset_outdoors(tgestate_t *state)
   state->room_index = room_NONE;
   get_supertiles(state);
   plot_all_tiles(state);
+  /* Conv: As in enter_room, the zoombox shows the window in full. */
+  state->rendering    = 1;
+  state->window_stale = 0;
   setup_movable_items(state);
   zoombox(state);
 }
@@ -6033,7 +6470,7 @@ void action_red_cross_parcel(tgestate_t *state)
 
   draw_all_items(state);
 
-  drop_item_tail(state, state->red_cross_parcel_current_contents);
+  drop_item_tail(state, state->cold.red_cross_parcel_current_contents);
 
   queue_message_for_display(state, message_YOU_OPEN_THE_BOX);
   increase_morale_by_10_score_by_50(state);
@@ -6071,7 +6508,7 @@ void action_bribe(tgestate_t *state)
   return;
 
 found:
-  state->bribed_character = character;
+  state->cold.bribed_character = character;
   vischar->flags = vischar_FLAGS_BRIBE_PENDING;
 }
 
@@ -6095,7 +6532,7 @@ void action_poison(tgestate_t *state)
 
   state->item_structs[item_FOOD].item_and_flags |= itemstruct_ITEM_FLAG_POISONED;
 
-  state->item_attributes[item_FOOD] = attribute_BRIGHT_PURPLE_OVER_BLACK;
+  state->cold.item_attributes[item_FOOD] = attribute_BRIGHT_PURPLE_OVER_BLACK;
 
   draw_all_items(state);
 
@@ -6142,13 +6579,13 @@ void action_shovel(tgestate_t *state)
   if (state->room_index != room_50_BLOCKED_TUNNEL)
     return; /* Shovel only works in the blocked tunnel room. */
 
-  if (roomdef_50_blocked_tunnel[2] == 255)
+  if (state->cold.roomdefs.blocked_tunnel[2] == 255)
     return; /* Blockage is already cleared. */
 
   /* Release boundary. */
-  roomdef_50_blocked_tunnel[2] = 255;
+  state->cold.roomdefs.blocked_tunnel[2] = 255;
   /* Remove blockage graphic. */
-  roomdef_50_blocked_tunnel[roomdef_50_BLOCKAGE] = interiorobject_STRAIGHT_TUNNEL_SW_NE;
+  state->cold.roomdefs.blocked_tunnel[roomdef_50_BLOCKAGE] = interiorobject_STRAIGHT_TUNNEL_SW_NE;
 
   setup_room(state);
   choose_game_window_attributes(state);
@@ -6259,7 +6696,7 @@ void action_lockpick(tgestate_t *state)
   if (pdoor == NULL)
     return; /* Wrong door? */
 
-  state->ptr_to_door_being_lockpicked = pdoor;
+  state->cold.ptr_to_door_being_lockpicked = pdoor;
   state->player_locked_out_until = state->game_counter + 255;
   state->vischars[0].flags = vischar_FLAGS_PICKING_LOCK;
   queue_message_for_display(state, message_PICKING_THE_LOCK);
@@ -6693,7 +7130,7 @@ void reset_game(tgestate_t *state)
   state->vischars[0].flags = 0;
 
   /* Reset score. */
-  memset(&state->score_digits[0], 0, 5);
+  memset(&state->cold.score_digits[0], 0, 5);
 
   /* Reset morale. */
   state->morale = morale_MAX;
@@ -6753,7 +7190,7 @@ void reset_map_and_characters(tgestate_t *state)
   uint8_t                          iters;   /* was B */
   vischar_t                       *vischar; /* was HL */
   uint8_t                         *gate;    /* was HL */
-  uint8_t *const                  *bed;     /* was HL */
+  int                              bed;     /* was HL */
   characterstruct_t               *charstr; /* was DE */
   uint8_t                          iters2;  /* was C */
   const character_reset_partial_t *reset;   /* was HL */
@@ -6769,8 +7206,8 @@ void reset_map_and_characters(tgestate_t *state)
   state->clock = 7;
   state->day_or_night = 0;
   state->vischars[0].flags = 0;
-  roomdef_50_blocked_tunnel[roomdef_50_BLOCKAGE] = interiorobject_COLLAPSED_TUNNEL_SW_NE;
-  roomdef_50_blocked_tunnel[2] = 0x34; /* Reset boundary. */
+  state->cold.roomdefs.blocked_tunnel[roomdef_50_BLOCKAGE] = interiorobject_COLLAPSED_TUNNEL_SW_NE;
+  state->cold.roomdefs.blocked_tunnel[2] = 0x34; /* Reset boundary. */
 
   /* Lock the gates. */
   gate = &state->gates_and_doors[0];
@@ -6781,19 +7218,19 @@ void reset_map_and_characters(tgestate_t *state)
 
   /* Reset all beds. */
   iters = beds_LENGTH;
-  bed = &beds[0];
+  bed = 0;
   do
-    **bed = interiorobject_OCCUPIED_BED;
+    *get_bed(state, bed) = interiorobject_OCCUPIED_BED;
   while (--iters);
 
   /* Clear the mess halls. */
-  roomdef_23_breakfast[roomdef_23_BENCH_A] = interiorobject_EMPTY_BENCH;
-  roomdef_23_breakfast[roomdef_23_BENCH_B] = interiorobject_EMPTY_BENCH;
-  roomdef_23_breakfast[roomdef_23_BENCH_C] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_D] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_E] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_F] = interiorobject_EMPTY_BENCH;
-  roomdef_25_breakfast[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_A] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_B] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_23[roomdef_23_BENCH_C] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_D] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_E] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_F] = interiorobject_EMPTY_BENCH;
+  state->cold.roomdefs.breakfast_25[roomdef_25_BENCH_G] = interiorobject_EMPTY_BENCH;
 
   /* Reset characters 12..15 (guards) and 20..25 (prisoners). */
   charstr = &state->character_structs[character_12_GUARD_12];
@@ -6836,7 +7273,7 @@ void searchlight_mask_test(tgestate_t *state, vischar_t *vischar)
   if (vischar > &state->vischars[0])
     return; /* Skip non-hero characters. */
 
-  buf = &state->mask_buffer[0x31]; // 0x31 = 32 + 17 ... but unsure if 32 is the right rowsize // could be 12*4+1
+  buf = &state->mask_buffer.bytes[0x31]; // 0x31 = 32 + 17 ... but unsure if 32 is the right rowsize // could be 12*4+1
   iters = 8;
   /* Bug: Original code does a fused load of BC, but doesn't use C after.
    * Probably a leftover stride constant. */
@@ -6864,45 +7301,60 @@ still_in_spotlight:
 
 /* ----------------------------------------------------------------------- */
 
-#define item_FOUND (1 << 6) // set by get_greatest_itemstruct
+#define item_FOUND (1 << 6) // set by get_nearby_itemstructs
 
 /**
  * $B866: Seems to locate things to plot, then invoke masked sprite plotter
  * on those things.
  *
+ * Conv: The original repeatedly called locate_vischar_or_itemstruct to find
+ * the next furthest away vischar or item, rescanning every vischar and item
+ * each time. Instead the frame's draw list is built once and sorted by
+ * depth, then plotted back-to-front.
+ *
  * \param[in] state Pointer to game state.
  */
 void locate_vischar_or_itemstruct_then_plot(tgestate_t *state)
 {
+  drawable_t    drawables[drawables_LENGTH];
+  int           count;
+  int           found;
+  int           hero_in_searchlight;
   uint8_t       index;      /* was A */
   vischar_t    *vischar;    /* was IY */
   itemstruct_t *itemstruct; /* was IY */
-  int           found;      /* was Z */
 
   assert(state != NULL);
 
-  for (;;)
-  {
-    /* This can return a vischar OR an itemstruct, but not both. */
-    found = locate_vischar_or_itemstruct(state, &index, &vischar, &itemstruct);
-    if (!found)
-      return;
-
-#ifndef NDEBUG
-    if (vischar)
-      ASSERT_VISCHAR_VALID(vischar);
-    else
-      assert(itemstruct != NULL);
-#endif
+  count = locate_vischars_and_itemstructs(state, &drawables[0]);
+  sort_drawables_by_depth(&drawables[0], count);
 
+  /* The list is in ascending order of depth: walk it backwards so that the
+   * furthest away things are plotted first. */
+  while (count--)
+  {
+    index = drawables[count].index;
     if ((index & item_FOUND) == 0)
     {
+      vischar = &state->vischars[index];
+      ASSERT_VISCHAR_VALID(vischar);
+      state->IY = vischar;
+
       found = setup_vischar_plotting(state, vischar);
       if (found)
       {
+        /* Conv: When not rendering the mask is still built for the hero
+         * since the searchlight test depends on it. */
+        hero_in_searchlight = vischar == &state->vischars[0] &&
+                              state->searchlight_state != searchlight_STATE_SEARCHING;
+        if (!state->rendering && !hero_in_searchlight)
+          continue;
+
         render_mask_buffer(state);
         if (state->searchlight_state != searchlight_STATE_SEARCHING)
           searchlight_mask_test(state, vischar);
+        if (!state->rendering)
+          continue;
         if (vischar->width_bytes != 3)
           masked_sprite_plotter_24_wide(state, vischar);
         else
@@ -6911,8 +7363,11 @@ void locate_vischar_or_itemstruct_then_plot(tgestate_t *state)
     }
     else
     {
+      itemstruct = &state->item_structs[index & ~item_FOUND];
+      state->IY = (vischar_t *) itemstruct; // FIXME: Cast is a bodge.
+
       found = setup_item_plotting(state, itemstruct, index);
-      if (found)
+      if (found && state->rendering)
       {
         render_mask_buffer(state);
         masked_sprite_plotter_16_wide_searchlight(state);
@@ -6924,103 +7379,194 @@ void locate_vischar_or_itemstruct_then_plot(tgestate_t *state)
 /* ----------------------------------------------------------------------- */
 
 /**
- * $B89C: Locates a vischar or item to plot.
+ * $B89C: Locates all the vischars and items to plot this frame.
  *
- * Only called from searchlight().
+ * Conv: The original located only the single furthest away vischar or item
+ * per call. This gathers every candidate into a draw list, clearing the
+ * flags which the original cleared as each was located.
  *
- * \param[in]  state       Pointer to game state.
- * \param[out] pindex      If vischar, returns vischars_LENGTH - iters; if itemstruct, returns ((item__LIMIT - iters) | (1 << 6)). (was A)
- * \param[out] pvischar    Pointer to receive vischar pointer. (was IY)
- * \param[out] pitemstruct Pointer to receive itemstruct pointer. (was IY)
+ * \param[in]  state     Pointer to game state.
+ * \param[out] drawables Draw list to fill. Must have room for
+ *                       drawables_LENGTH entries.
  *
- * \return State of Z flag: 1 if Z, 0 if NZ. // unsure which is found/notfound right now
+ * \return Count of entries written to drawables.
  */
-int locate_vischar_or_itemstruct(tgestate_t    *state,
-                                 uint8_t       *pindex,
-                                 vischar_t    **pvischar,
-                                 itemstruct_t **pitemstruct)
+int locate_vischars_and_itemstructs(tgestate_t *state,
+                                    drawable_t *drawables)
 {
-  uint16_t      x;                /* was BC */
-  uint16_t      y;                /* was DE */
-  item_t        item_and_flag;    /* was A' */
-  uint16_t      DEdash;           /* was DE' */
-  uint8_t       iters;            /* was B' */
-  vischar_t    *vischar;          /* was HL' */
-  vischar_t    *found_vischar;    /* was IY */
-  itemstruct_t *found_itemstruct; /* was IY */
-
-  assert(state       != NULL);
-  assert(pindex      != NULL);
-  assert(pvischar    != NULL);
-  assert(pitemstruct != NULL);
+  drawable_t *drawable; /* was HL' */
+  uint8_t     iters;    /* was B' */
+  vischar_t  *vischar;  /* was HL' */
 
-  *pvischar    = NULL;
-  *pitemstruct = NULL;
+  assert(state     != NULL);
+  assert(drawables != NULL);
 
-  x             = 0; // prev-x
-  y             = 0; // prev-y
-  item_and_flag = item_NONE; // 'nothing found' marker 0xFF
-  DEdash        = 0;
+  /* Items go in first so that, when depths tie, vischars are plotted
+   * before items as they were in the original. */
+  drawable = get_nearby_itemstructs(state, drawables);
 
-  iters   = vischars_LENGTH; /* iterations */
+  iters   = vischars_LENGTH;
   vischar = &state->vischars[0]; /* Conv: Original points to $8007. */
   do
   {
-    if ((vischar->counter_and_flags & vischar_BYTE7_LOCATABLE) == 0)
-      goto next;
-
-    if ((vischar->mi.pos.x + 4 < x) ||
-        (vischar->mi.pos.y + 4 < y))
-      goto next;
-
-    item_and_flag = vischars_LENGTH - iters; /* Item index. */ // BC' is temp.
-    DEdash = vischar->mi.pos.height;
-
-    y = vischar->mi.pos.y; /* Note: The y,x order here is correct. */
-    x = vischar->mi.pos.x;
-    state->IY = found_vischar = vischar;
+    if (vischar->counter_and_flags & vischar_BYTE7_LOCATABLE)
+    {
+      vischar->counter_and_flags &= ~vischar_BYTE7_LOCATABLE;
 
-next:
+      assert(vischar->mi.pos.x + vischar->mi.pos.y <= UINT16_MAX);
+      drawable->depth = vischar->mi.pos.x + vischar->mi.pos.y;
+      drawable->index = vischars_LENGTH - iters; /* Vischar index. */
+      drawable++;
+    }
     vischar++;
   }
   while (--iters);
 
-  // IY is returned from this, but is an itemstruct_t not a vischar
-  // item_and_flag is passed through if no itemstruct is found.
-  item_and_flag = get_greatest_itemstruct(state,
-                                          item_and_flag,
-                                          x,y,
-                                          &found_itemstruct);
-  *pindex = item_and_flag; // Conv: Additional code.
-  /* If Adash's top bit remains set from initialisation, then no vischar was
-   * found. (It's not affected by get_greatest_itemstruct which passes it
-   * through). */
-  if (item_and_flag & (1 << 7))
-    return 0; // NZ => not found
+  return drawable - drawables;
+}
 
-  if ((item_and_flag & item_FOUND) == 0)
-  {
-    found_vischar->counter_and_flags &= ~vischar_BYTE7_LOCATABLE;
+/* ----------------------------------------------------------------------- */
 
-    *pvischar = found_vischar; // Conv: Additional code.
+/**
+ * Sort a draw list into ascending order of depth.
+ *
+ * Conv: Added. This is a two pass LSD radix sort on the 16-bit depth. It's
+ * stable, so entries of equal depth keep the order in which they were
+ * located.
+ *
+ * Leaf.
+ *
+ * \param[in,out] drawables Draw list.
+ * \param[in]     count     Count of entries in drawables.
+ */
+void sort_drawables_by_depth(drawable_t *drawables, int count)
+{
+  drawable_t  scratch[drawables_LENGTH];
+  drawable_t *src;
+  drawable_t *dst;
+  drawable_t *tmp;
+  int         offsets[256];
+  int         shift;
+  int         total;
+  int         i;
 
-    return 1; // Z => found
-  }
-  else
+  assert(drawables != NULL);
+  assert(count >= 0 && count <= drawables_LENGTH);
+
+  src = drawables;
+  dst = &scratch[0];
+  for (shift = 0; shift < 16; shift += 8)
   {
-    int Z;
+    /* Count occurrences of each digit. */
+    memset(offsets, 0, sizeof(offsets));
+    for (i = 0; i < count; i++)
+      offsets[(src[i].depth >> shift) & 0xFF]++;
 
-    found_itemstruct->room_and_flags &= ~itemstruct_ROOM_FLAG_NEARBY_6;
-    Z = (found_itemstruct->room_and_flags & itemstruct_ROOM_FLAG_NEARBY_6) == 0; // was BIT 6,HL[1] // this tests the bit we've just cleared
+    /* Convert counts into starting offsets. */
+    total = 0;
+    for (i = 0; i < 256; i++)
+    {
+      int n = offsets[i];
+      offsets[i] = total;
+      total += n;
+    }
 
-    *pitemstruct = found_itemstruct; // Conv: Additional code.
+    /* Scatter. */
+    for (i = 0; i < count; i++)
+      dst[offsets[(src[i].depth >> shift) & 0xFF]++] = src[i];
 
-    return Z; // check the sense isn't flipped
+    tmp = src;
+    src = dst;
+    dst = tmp;
   }
+
+  /* An even number of passes leaves the result back in drawables. */
+  assert(src == drawables);
 }
 
 /* ----------------------------------------------------------------------- */
 
+/**
+ * Run-length decoder state for a mask.
+ *
+ * Conv: The original interleaved run decoding with clipping using a web of
+ * self-modified counters. This is factored out into a cursor so that the
+ * row loop in render_mask_buffer can skip whole runs at once. It also
+ * reads masks which an asset pack holds already decoded.
+ */
+typedef struct maskcursor
+{
+  const uint8_t *data;     /* next encoded byte */
+  const uint8_t *end;      /* end of encoded data */
+  uint8_t        run;      /* copies of tile still to be returned */
+  tileindex_t    tile;     /* tile being repeated */
+  int            expanded; /* data is plain tile indices */
+}
+maskcursor_t;
+
+/**
+ * Returns the next mask tile index, decoding a new run if required. Returns
+ * the transparent tile once the data is exhausted.
+ */
+static tileindex_t mask_cursor_next(maskcursor_t *cursor)
+{
+  uint8_t byte;
+
+  if (cursor->expanded)
+    return cursor->data < cursor->end ? *cursor->data++ : 0;
+
+  if (cursor->run == 0)
+  {
+    if (cursor->data >= cursor->end)
+      return 0;
+
+    byte = *cursor->data++;
+    if (byte & (1 << 7))
+    {
+      cursor->run  = byte & 0x7F;
+      cursor->tile = *cursor->data++;
+    }
+    else
+    {
+      cursor->run  = 1;
+      cursor->tile = byte;
+    }
+  }
+  cursor->run--;
+
+  return cursor->tile;
+}
+
+/** Skips the given number of mask tiles. */
+static void mask_cursor_skip(maskcursor_t *cursor, int count)
+{
+  int take;
+
+  if (cursor->expanded)
+  {
+    if (count > 0)
+      cursor->data += MIN(count, cursor->end - cursor->data);
+    return;
+  }
+
+  while (count > 0)
+  {
+    if (cursor->run == 0)
+    {
+      if (cursor->data >= cursor->end)
+        return;
+
+      (void) mask_cursor_next(cursor); /* load the next run */
+      count--;
+      continue;
+    }
+
+    take = MIN(cursor->run, count);
+    cursor->run -= take;
+    count       -= take;
+  }
+}
+
 /**
  * $B916: Render the mask buffer.
  *
@@ -7030,11 +7576,13 @@ void render_mask_buffer(tgestate_t *state)
 {
   uint8_t       iters; /* was B */
   const mask_t *pmask; /* was HL */
+  int           i;
 
   assert(state != NULL);
 
   /* Clear the whole mask buffer. */
-  memset(&state->mask_buffer[0], 0xFF, NELEMS(state->mask_buffer));
+  for (i = 0; i < NELEMS(state->mask_buffer.words); i++)
+    state->mask_buffer.words[i] = ~UINT64_C(0);
 
   if (state->room_index > room_0_OUTDOORS)
   {
@@ -7053,15 +7601,9 @@ void render_mask_buffer(tgestate_t *state)
     /* Outdoors */
 
     iters = NELEMS(exterior_mask_data); // Bug? Was 59 (one too large).
-    pmask = &exterior_mask_data[0]; // off by - 2 bytes; original points to $EC03, table starts at $EC01 // fix by propagation
+    pmask = &assets->exterior_mask_data[0]; // off by - 2 bytes; original points to $EC03, table starts at $EC01 // fix by propagation
   }
 
-  uint8_t            A;           /* was A */
-  const uint8_t     *DE;          /* was DE */
-//  uint16_t           HL;          /* was HL */
-  uint16_t           count_of_something; /* was HL */
-  uint8_t *mask_buffer_pointer; /* was $81A0 */
-
   /* Mask against all. */
   do
   {
@@ -7075,14 +7617,6 @@ void render_mask_buffer(tgestate_t *state)
     uint8_t clip_y1; /* was $B839 */ // y0 offset 2
     uint8_t clip_x1; /* was $B83A */ // x0 offset 2
 
-//    uint8_t byte_B839; /* was $BA70 - self modified */
-//    uint8_t byte_B83A; /* was $BA72 - self modified */
-    uint8_t self_BA90; /* was $BA90 - self modified */
-    uint8_t skip;      /* was $BABA - self modified */
-
-    // PUSH BC
-    // PUSH HLeb
-
     // pmask->bounds is a visual position on the map image
     // pmask->pos is a map position
     // so we can cull masks if not on-screen
@@ -7090,25 +7624,23 @@ void render_mask_buffer(tgestate_t *state)
 
     x = state->screenpos.x;
     if (x - 1 >= pmask->bounds.x1 || x + 2 <= pmask->bounds.x0) // $EC03, $EC02
-      goto pop_next;
+      goto next;
 
     y = state->screenpos.y;
     if (y - 1 >= pmask->bounds.y1 || y + 3 <= pmask->bounds.y0) // $EC05, $EC04
-      goto pop_next;
+      goto next;
 
     if (state->tinypos_stash.x <= pmask->pos.x) // $EC06
-      goto pop_next;
+      goto next;
 
     if (state->tinypos_stash.y < pmask->pos.y) // $EC07
-      goto pop_next;
+      goto next;
 
     height = state->tinypos_stash.height;
     if (height)
       height--; // make inclusive?
     if (height >= pmask->pos.height) // $EC08
-      goto pop_next;
-
-    // redundant: HLeb -= 6;
+      goto next;
 
     /* Clipping. */
     // likely clip_x1 is a width and clip_y1 is a height
@@ -7142,11 +7674,13 @@ void render_mask_buffer(tgestate_t *state)
       clip_y1 = MIN((pmask->bounds.y1 - y0) + 1, 5 - (y0 - mpr2));
     }
 
-    // In the original code, HLeb is here decremented to point at member y0.
-
     {
-      uint8_t x, y;   /* was B, C */ // x,y are the correct way around here i think!
-      uint8_t index;  /* was A */
+      uint8_t       x, y;     /* was B, C */ // x,y are the correct way around here i think!
+      uint8_t       index;    /* was A */
+      uint8_t       width;    /* was *DE */
+      int           trailing; /* was $BA90 - self modified */
+      maskcursor_t  cursor;
+      uint64_t     *dst;      /* was $81A0 */
 
       x = y = 0;
       if (clip_y0 == 0)
@@ -7154,151 +7688,64 @@ void render_mask_buffer(tgestate_t *state)
       if (clip_x0 == 0)
         x = -state->screenpos.x + pmask->bounds.x0;
 
+      assert(x + clip_x1 <= MASK_BUFFER_ROWBYTES);
+      assert(y + clip_y1 <= MASK_BUFFER_HEIGHT);
+
       index = pmask->index;
       assert(index < NELEMS(mask_pointers));
 
-      mask_buffer_pointer = &state->mask_buffer[y * MASK_BUFFER_WIDTH + x];
-
-      DE = mask_pointers[index];
-//      HL = byte_B839 | (byte_B83A << 8); // vertical bits // fused then split apart again immediately below
-//
-//      self_BA70 = (HL >> 0) & 0xFF; // self modify
-//      self_BA72 = (HL >> 8) & 0xFF; // self modify
-      self_BA90 = *DE - clip_x1; // self modify // *DE looks like a count
-      skip = MASK_BUFFER_WIDTH - clip_x1; // self modify
-    }
-
-    // skip count? == width * yskip + xskip + 1
-    count_of_something = multiply(clip_y0, *DE); // DE is the same count as fetched above // sets D to 0
-    count_of_something += clip_x0; // horz // was +DE, but D is zero
-    count_of_something++; /* iterations */
+      if (assets->masks)
+      {
+        /* Conv: The mask was decoded when the asset pack was made. */
+        const expandedmask_t *expanded = &assets->masks[index];
 
-    // is this skipping the initial cliped edge, for runs?
-    do
-    {
-    ba4d:
-      A = *DE; // DE -> $E560 upwards (in exterior_mask_data) // count byte
-      if (A & (1 << 7))
+        width           = expanded->width;
+        cursor.data     = (const uint8_t *) assets->masks + expanded->offset;
+        cursor.end      = cursor.data + width * expanded->height;
+        cursor.expanded = 1;
+      }
+      else
       {
-        A &= 0x7F;
-        DE++;
-        count_of_something -= A;
-        if (count_of_something < 0) // need a signed type?
-          goto ba69;
-        DE++;
-        if (count_of_something != 0) // still more to skip?
-          goto ba4d;
-
-        // start A
-        A = 0;
-        goto ba6c;
+        width           = *mask_pointers[index];
+        cursor.data     = mask_pointers[index] + 1;
+        cursor.end      = mask_pointers[index] + mask_lengths[index];
+        cursor.expanded = 0;
       }
-      DE++;
-    }
-    while (--count_of_something);
-    goto ba6c;
+      cursor.run  = 0;
+      cursor.tile = 0;
 
-  ba69:
-    // start A
-    A = -(count_of_something & 0xFF);
+      /* Skip the rows above and the columns left of the visible part. */
+      mask_cursor_skip(&cursor, clip_y0 * width + clip_x0);
 
-  ba6c:
-    {
-      uint8_t *maskbufptr; /* was HL */
-      uint8_t  iters2;     /* was C */
+      trailing = width - clip_x1;
 
-      maskbufptr = mask_buffer_pointer;
-      // R I:C Iterations (inner loop);
-      iters2 = clip_y1; // self modified // height
-      do
+      dst = &state->mask_buffer.words[y * MASK_BUFFER_WIDTH / 8];
+      for (;;)
       {
-        uint8_t iters3; /* was B */
-        uint8_t counter; /* was A' */
+        /* Conv: Gather a whole row of tiles, padded out to the buffer's
+         * width with transparent tiles, and mask it in one go. This avoids
+         * recomputing the clipped span for every row. */
+        tileindex_t tiles[MASK_BUFFER_ROWBYTES] = { 0 };
+        uint8_t     col;
 
-        iters3 = clip_x1; // self modified // looks more like a width than an x1
-        do
-        {
-          counter = *DE; // count byte
-          if (counter & (1 << 7))
-          {
-            counter &= 0x7F;
-            DE++;
-            A = *DE; // read next byte
-          }
-
-          if (A != 0) // zero value must be an assumed totally blank mask tile
-            mask_against_tile(A, maskbufptr); // tile index, dst
-
-          maskbufptr++;
-
-          if (counter != 0 && --counter != 0)
-            DE--;
-          DE++;
-        }
-        while (--iters3);
+        for (col = x; col < x + clip_x1; col++)
+          tiles[col] = mask_cursor_next(&cursor);
 
-        // PUSH BC
+        mask_against_tile(tiles, dst);
+        dst += MASK_BUFFER_WIDTH / 8;
 
-        // trailing skip?
-        iters3 = self_BA90; // self modified
-        if (iters3)
-        {
-          if (A)
-            goto baa3;
-
-        ba9b:
-          do
-          {
-            A = *DE; // count byte
-            if (A & (1 << 7))
-            {
-              A &= 0x7F;
-              DE++;
-
-            baa3:
-              iters3 -= A;
-              if (iters3 < 0)
-                goto bab6;
-              DE++;
-              if (iters3 != 0)
-                goto ba9b;
-
-              // EX AF,AF' // why not just jump instr earlier? // bank
-              goto bab9;
-            }
-
-            DE++;
-          }
-          while (--iters3);
-
-          A = 0;
-          // EX AF,AF' // why not just jump instr earlier? // bank
-
-          goto bab9;
-
-        bab6:
-          A = -A;
-          // EX AF,AF' // bank
-        }
+        if (--clip_y1 == 0)
+          break;
 
-      bab9:
-        maskbufptr += skip; // self modified
-        // EX AF,AF'  // unbank
-        // POP BC
+        /* Skip the rest of this row and the start of the next. */
+        mask_cursor_skip(&cursor, trailing);
       }
-      while (--iters2);
     }
 
-  pop_next:
-    // POP HLeb
-    // POP BC
+  next:
     pmask++; // stride is 1 mask_t
   }
   while (--iters);
-
-  // This scales A by B then returns nothing: is it really doing this for no good reason?
-  // It was a falthrough in the original code so assuming it was a missing RET.
-  // count_of_something = multiply(A, 8);
 }
 
 /**
@@ -7348,30 +7795,59 @@ uint16_t multiply(uint8_t left, uint8_t right)
 /* ----------------------------------------------------------------------- */
 
 /**
- * $BADC: Masks tiles (placed in a stride-of-4 arrangement) by the specified
- * index mask_tiles (set zero).
+ * $BADC: Masks a row of tiles in the mask buffer by the specified mask_tiles
+ * (set zero).
  *
  * Leaf.
  *
- * \param[in] index Mask tile index.                (was A)
- * \param[in] dst   Pointer to a tile to be masked. (was HL)
+ * Conv: The original masked a single tile, one byte at a time, at a stride
+ * of four. This masks a whole row of four tiles using 64-bit words. Tile
+ * index zero is transparent and leaves its column untouched.
+ *
+ * \param[in] tiles Mask tile indices, one per column. (was A)
+ * \param[in] dst   Pointer to a row of the mask buffer. (was HL)
  */
-void mask_against_tile(tileindex_t index, tilerow_t *dst)
+void mask_against_tile(const tileindex_t *tiles,
+                       uint64_t         *dst)
 {
-  const tilerow_t *row;   /* was HL' */
-  uint8_t          iters; /* was B */
+  union
+  {
+    uint64_t  words[MASK_BUFFER_WIDTH / 8];
+    tilerow_t rows[MASK_BUFFER_WIDTH];
+  }
+  mask;
+  int col;
+  int row;
+  int i;
+  int any;
 
-  assert(index < 111);
-  assert(dst != NULL); // which buffer does this point to?
+  assert(tiles != NULL);
+  assert(dst != NULL);
 
-  row = &mask_tiles[index].row[0];
-  iters = 8;
-  do
+  any = 0;
+  for (i = 0; i < NELEMS(mask.words); i++)
+    mask.words[i] = ~UINT64_C(0);
+
+  for (col = 0; col < MASK_BUFFER_ROWBYTES; col++)
   {
-    *dst &= *row++;
-    dst += 4; /* supertile stride? */
+    const tilerow_t *src;
+
+    if (tiles[col] == 0)
+      continue;
+
+    assert(tiles[col] < NELEMS(mask_tiles));
+
+    src = &assets->mask_tiles[tiles[col]].row[0];
+    for (row = 0; row < 8; row++)
+      mask.rows[row * MASK_BUFFER_ROWBYTES + col] = src[row];
+    any = 1;
   }
-  while (--iters);
+
+  if (!any)
+    return;
+
+  for (i = 0; i < NELEMS(mask.words); i++)
+    dst[i] &= mask.words[i];
 }
 
 /* ----------------------------------------------------------------------- */
@@ -7581,6 +8057,8 @@ clamp_height: // was $BBF8
     tilebuf = &state->tile_buf[x + y * state->columns];
     ASSERT_TILE_BUF_PTR_VALID(tilebuf);
 
+    mark_window_buf_dirty(state, windowbuf, width, height * 8);
+
     height_counter = height;
     do
     {
@@ -7654,7 +8132,7 @@ const tile_t *select_tile_set(tgestate_t *state,
 
   if (state->room_index != room_0_OUTDOORS)
   {
-    tileset = &interior_tiles[0];
+    tileset = &assets->interior_tiles[0];
   }
   else
   {
@@ -7664,12 +8142,12 @@ const tile_t *select_tile_set(tgestate_t *state,
     offset     = ((((state->map_position.x & 3) + x) >> 2) & 0x3F) + row_offset; // combines horizontal + vertical
 
     tile = state->map_buf[offset]; /* (7x5) supertile refs */
-    tileset = &exterior_tiles_1[0];
+    tileset = &assets->exterior_tiles[0][0];
     if (tile >= 45)
     {
-      tileset = &exterior_tiles_2[0];
+      tileset = &assets->exterior_tiles[1][0];
       if (tile >= 139 && tile < 204)
-        tileset = &exterior_tiles_3[0];
+        tileset = &assets->exterior_tiles[2][0];
     }
   }
   return tileset;
@@ -8008,11 +8486,11 @@ void reset_visible_character(tgestate_t *state, vischar_t *vischar)
 
     /* Save the old position. */
     if (character == character_26_STOVE_1)
-      pos = &state->movable_items[movable_item_STOVE1].pos;
+      pos = &state->cold.movable_items[movable_item_STOVE1].pos;
     else if (character == character_27_STOVE_2)
-      pos = &state->movable_items[movable_item_STOVE2].pos;
+      pos = &state->cold.movable_items[movable_item_STOVE2].pos;
     else
-      pos = &state->movable_items[movable_item_CRATE].pos;
+      pos = &state->cold.movable_items[movable_item_CRATE].pos;
     memcpy(pos, &vischar->mi.pos, sizeof(*pos));
   }
   else
@@ -8075,7 +8553,7 @@ void reset_visible_character(tgestate_t *state, vischar_t *vischar)
 /**
  * $C651: Gets a new target.
 
- if location->x is 0xff then it picks a location from state->locations[] indexed by location->y but with the bottom three bits randomised
+ if location->x is 0xff then it picks a location from state->cold.locations[] indexed by location->y but with the bottom three bits randomised
  else ...
 
  *
@@ -8152,10 +8630,10 @@ uint8_t get_next_target(tgestate_t *state,
     }
   }
 
-  assert(y < NELEMS(state->locations));
+  assert(y < NELEMS(state->cold.locations));
 
   // sampled A = $38,2D,02,06,1E,20,21,3C,23,2B,3A,0B,2D,04,03,1C,1B,21,3C,...
-  *target_out = &state->locations[y];
+  *target_out = &state->cold.locations[y];
 
   return 0;
 }
@@ -8355,7 +8833,7 @@ character_12_or_higher:
         max = 6;
 
       // sampled HL at $C77A = 787a, 787e, 7888, 7890, 78aa, 783a, 786a, 7896, 787c,
-      // => state->locations[]
+      // => state->cold.locations[]
       // HL comes from HLtarget
 
       B = 0;
@@ -8753,8 +9231,8 @@ void follow_suspicious_character(tgestate_t *state)
     hostiles_persue(state);
 
   /* If food was dropped then count down until it is discovered. */
-  if (state->food_discovered_counter != 0 &&
-      --state->food_discovered_counter == 0)
+  if (state->cold.food_discovered_counter != 0 &&
+      --state->cold.food_discovered_counter == 0)
   {
     /* De-poison the food. */
     state->item_structs[item_FOOD].item_and_flags &= ~itemstruct_ITEM_FLAG_POISONED;
@@ -8881,7 +9359,7 @@ set_p04:
       character_t  bribed_character; /* was A */
       vischar_t   *found;            /* was HL */
 
-      bribed_character = state->bribed_character;
+      bribed_character = state->cold.bribed_character;
       if (bribed_character != character_NONE)
       {
         /* Iterate over non-player characters. */
@@ -9147,7 +9625,7 @@ void bribes_solitary_food(tgestate_t *state, vischar_t *vischar)
   {
     if (flags_lower6 == vischar_FLAGS_BRIBE_PENDING)
     {
-      if (vischar->character == state->bribed_character)
+      if (vischar->character == state->cold.bribed_character)
         accept_bribe(state, vischar);
       else
         solitary(state); // failed to bribe?
@@ -9165,7 +9643,7 @@ void bribes_solitary_food(tgestate_t *state, vischar_t *vischar)
       food_discovered_counter = 32; /* food is not poisoned */
     else
       food_discovered_counter = 255; /* food is poisoned */
-    state->food_discovered_counter = food_discovered_counter;
+    state->cold.food_discovered_counter = food_discovered_counter;
 
     vischar->target.x = 0x00;
 
@@ -10393,34 +10871,24 @@ void mark_nearby_items(tgestate_t *state)
 /**
  * $DBEB: Iterates over all item_structs looking for nearby items.
  *
- * Returns the furthest/highest/nearest item?
+ * Conv: The original returned only the furthest away nearby item. This adds
+ * every nearby item to the draw list, clearing the flag which the original
+ * cleared as each was located.
  *
  * Leaf.
  *
- * \param[in]  state         Pointer to game state.
- * \param[in]  item_and_flag Initial item_and_flag, passed through if no itemstruct is found. (was A')
- * \param[in]  x             X pos? Compared to X. (was BC') // sampled BCdash = $26, $3E, $00, $26, $34, $22, $32
- * \param[in]  y             Y pos? Compared to Y. (was DE')
- * \param[out] pitemstr      Returned pointer to item struct. (was IY)
+ * \param[in]  state     Pointer to game state.
+ * \param[out] drawables Draw list to append to.
  *
- * \return item+flag. (was A')
+ * \return Pointer to the draw list entry following the last one written.
  */
-uint8_t get_greatest_itemstruct(tgestate_t    *state,
-                                item_t         item_and_flag,
-                                uint16_t       x,
-                                uint16_t       y,
-                                itemstruct_t **pitemstr)
+drawable_t *get_nearby_itemstructs(tgestate_t *state, drawable_t *drawables)
 {
-  uint8_t             iters;   /* was B */
-  const itemstruct_t *itemstr; /* was HL */
-
-  assert(state    != NULL);
-  // assert(item_and_flag);
-  // assert(x);
-  // assert(y);
-  assert(pitemstr != NULL);
+  uint8_t       iters;   /* was B */
+  itemstruct_t *itemstr; /* was HL */
 
-  *pitemstr = NULL; /* Conv: Added safety initialisation. */
+  assert(state     != NULL);
+  assert(drawables != NULL);
 
   iters   = item__LIMIT;
   itemstr = &state->item_structs[0]; /* Conv: Original pointed to itemstruct->room_and_flags. */
@@ -10431,31 +10899,18 @@ uint8_t get_greatest_itemstruct(tgestate_t    *state,
 
     if ((itemstr->room_and_flags & FLAGS) == FLAGS)
     {
-      /* Conv: Original calls out to multiply by 8, HLdash is temp. */
-      if (itemstr->pos.x * 8 > x &&
-          itemstr->pos.y * 8 > y)
-      {
-        const tinypos_t *pos; /* was HL' */
-
-        pos = &itemstr->pos; /* Conv: Was direct pointer, now points to member. */
-        /* Get x,y for the next iteration. */
-        y = pos->y * 8;
-        x = pos->x * 8;
-        *pitemstr = (itemstruct_t *) itemstr;
+      itemstr->room_and_flags &= ~itemstruct_ROOM_FLAG_NEARBY_6;
 
-        state->IY = (vischar_t *) itemstr; // FIXME: Cast is a bodge.
-
-        /* The original code has an unpaired A register exchange here. If the
-         * loop continues then it's unclear which output register is used. */
-        /* It seems that A' is the output register, irrespective. */
-        item_and_flag = (item__LIMIT - iters) | item_FOUND; // iteration count + 'item found' flag
-      }
+      /* Conv: Original calls out to multiply by 8. */
+      drawables->depth = itemstr->pos.x * 8 + itemstr->pos.y * 8;
+      drawables->index = (item__LIMIT - iters) | item_FOUND; // iteration count + 'item found' flag
+      drawables++;
     }
     itemstr++;
   }
   while (--iters);
 
-  return item_and_flag;
+  return drawables;
 }
 
 /* ----------------------------------------------------------------------- */
@@ -10481,10 +10936,9 @@ uint8_t setup_item_plotting(tgestate_t   *state,
   uint8_t       instr;          /* was A */
   uint8_t       A;              /* was A */
   uint8_t       offset_tmp;     /* was A' */
-  uint8_t       iters;          /* was B' */
   uint8_t       offset;         /* was C' */
 //  uint16_t      DEdash; /* was DE' */
-  const size_t *enables;        /* was HL' */
+  uint8_t       enables;        /* was HL' */
   int16_t       x, y;           // was HL, DE // signed needed for X calc
   uint8_t      *maskbuf;        /* was HL */
   uint16_t      skip;           /* was DE */
@@ -10537,17 +10991,12 @@ uint8_t setup_item_plotting(tgestate_t   *state,
 
   offset = offset_tmp; /* Future: Could assign directly to offset instead. */
 
-  /* Set the addresses in the jump table to NOP or LD (HL),A */
-  enables = &masked_sprite_plotter_16_enables[0];
-  iters = 3; /* iterations */
-  do
-  {
-    *(((uint8_t *) state) + *enables++) = instr;
-    *(((uint8_t *) state) + *enables++) = instr;
-    if (--offset == 0)
-      instr ^= 0x77; /* Toggle between LD (HL),A and NOP. */
-  }
-  while (--iters);
+  /* Conv: The original set the addresses in the jump table to NOP or
+   * LD (HL),A. Instead select row plotters specialised for the enabled
+   * columns. */
+  enables = make_masked_sprite_plotter_enables(instr, offset, 3);
+  state->masked_sprite_plotter_16_left  = state->renderer->masked_sprite_plotters_16_left[enables];
+  state->masked_sprite_plotter_16_right = state->renderer->masked_sprite_plotters_16_right[enables];
 
   y = 0; /* Conv: Moved. */
   if ((clipped_height >> 8) == 0)
@@ -10558,7 +11007,12 @@ uint8_t setup_item_plotting(tgestate_t   *state,
   state->window_buf_pointer = &state->window_buf[x + y]; // window buffer start address
   ASSERT_WINDOW_BUF_PTR_VALID(state->window_buf_pointer);
 
-  maskbuf = &state->mask_buffer[0];
+  mark_window_buf_dirty(state,
+                        state->window_buf_pointer,
+                        3,
+                        clipped_height & 0xFF);
+
+  maskbuf = &state->mask_buffer.bytes[0];
 
   // POP DE  // get clipped_height
   // PUSH DE
@@ -10723,311 +11177,675 @@ const spritedef_t item_definitions[item__LIMIT] =
 /* ----------------------------------------------------------------------- */
 
 /**
- * $E0E0: Addresses of self-modified locations which are changed between NOPs
- * and LD (HL),A.
+ * Expands X once for every possible mask of enabled columns in a 24 pixel
+ * wide (four byte) plot. NAME and COLUMNS are passed through.
+ */
+#define FOR_EACH_ENABLES_24(X, NAME, COLUMNS)                                 \
+  X(0,  NAME, COLUMNS) X(1,  NAME, COLUMNS)                                   \
+  X(2,  NAME, COLUMNS) X(3,  NAME, COLUMNS)                                   \
+  X(4,  NAME, COLUMNS) X(5,  NAME, COLUMNS)                                   \
+  X(6,  NAME, COLUMNS) X(7,  NAME, COLUMNS)                                   \
+  X(8,  NAME, COLUMNS) X(9,  NAME, COLUMNS)                                   \
+  X(10, NAME, COLUMNS) X(11, NAME, COLUMNS)                                   \
+  X(12, NAME, COLUMNS) X(13, NAME, COLUMNS)                                   \
+  X(14, NAME, COLUMNS) X(15, NAME, COLUMNS)
+
+/**
+ * Expands X once for every possible mask of enabled columns in a 16 pixel
+ * wide (three byte) plot. NAME and COLUMNS are passed through.
+ */
+#define FOR_EACH_ENABLES_16(X, NAME, COLUMNS)                                 \
+  X(0,  NAME, COLUMNS) X(1,  NAME, COLUMNS)                                   \
+  X(2,  NAME, COLUMNS) X(3,  NAME, COLUMNS)                                   \
+  X(4,  NAME, COLUMNS) X(5,  NAME, COLUMNS)                                   \
+  X(6,  NAME, COLUMNS) X(7,  NAME, COLUMNS)
+
+#define MASK(bm,mask) ((~*foremaskptr | (mask)) & *screenptr) | ((bm) & *foremaskptr)
+
+/**
+ * Defines a row plotter for the shift right case of
+ * masked_sprite_plotter_24_wide, specialised for the mask of enabled columns
+ * ENABLES (bit N set => column N is plotted), in a window COLUMNS wide.
+ *
+ * Conv: The original game enabled and disabled columns by self-modifying
+ * LD (HL),A instructions into NOPs. These were flags tested in every row.
+ */
+#define MASKED_SPRITE_PLOTTER_24_WIDE_RIGHT(ENABLES, NAME, COLUMNS)           \
+static void                                                                   \
+masked_sprite_plotter_24_wide_right_##NAME##_##ENABLES(tgestate_t *state,     \
+                                                       uint8_t     shift)     \
+{                                                                             \
+  uint8_t        x;           /* was A */                                     \
+  uint8_t        iters;       /* was B */                                     \
+  const uint8_t *maskptr;     /* was ? */                                     \
+  const uint8_t *bitmapptr;   /* was ? */                                     \
+  const uint8_t *foremaskptr; /* was ? */                                     \
+  uint8_t       *screenptr;   /* was ? */                                     \
+                                                                              \
+  maskptr   = state->mask_pointer;                                            \
+  bitmapptr = state->bitmap_pointer;                                          \
+                                                                              \
+  assert(maskptr   != NULL);                                                  \
+  assert(bitmapptr != NULL);                                                  \
+                                                                              \
+  iters = state->self_E121; /* clipped_height & 0xFF */                       \
+  do                                                                          \
+  {                                                                           \
+    uint8_t bm0, bm1, bm2, bm3;         /* was B, C, E, D */                  \
+    uint8_t mask0, mask1, mask2, mask3; /* was B', C', E', D' */              \
+    int     carry = 0;                                                        \
+                                                                              \
+    /* Load bitmap bytes into B,C,E. */                                       \
+    bm0 = *bitmapptr++;                                                       \
+    bm1 = *bitmapptr++;                                                       \
+    bm2 = *bitmapptr++;                                                       \
+                                                                              \
+    /* Load mask bytes into B',C',E'. */                                      \
+    mask0 = *maskptr++;                                                       \
+    mask1 = *maskptr++;                                                       \
+    mask2 = *maskptr++;                                                       \
+                                                                              \
+    if (state->sprite_index & sprite_FLAG_FLIP)                               \
+      flip_24_masked_pixels(state, &mask2, &mask1, &mask0, &bm2, &bm1, &bm0); \
+                                                                              \
+    foremaskptr = state->foreground_mask_pointer;                             \
+    screenptr   = state->window_buf_pointer;                                  \
+                                                                              \
+    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);                                   \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+                                                                              \
+    /* Shift bitmap. */                                                       \
+                                                                              \
+    bm3 = 0;                                                                  \
+    SRL(bm0);                                                                 \
+    RR(bm1);                                                                  \
+    RR(bm2);                                                                  \
+    RR(bm3);                                                                  \
+    if (shift >= 8)                                                           \
+    {                                                                         \
+      SRL(bm0);                                                               \
+      RR(bm1);                                                                \
+      RR(bm2);                                                                \
+      RR(bm3);                                                                \
+    }                                                                         \
+    if (shift >= 16)                                                          \
+    {                                                                         \
+      SRL(bm0);                                                               \
+      RR(bm1);                                                                \
+      RR(bm2);                                                                \
+      RR(bm3);                                                                \
+    }                                                                         \
+                                                                              \
+    /* Shift mask. */                                                         \
+                                                                              \
+    mask3 = 0xFF;                                                             \
+    carry = 1;                                                                \
+    RR(mask0);                                                                \
+    RR(mask1);                                                                \
+    RR(mask2);                                                                \
+    RR(mask3);                                                                \
+    if (shift >= 8)                                                           \
+    {                                                                         \
+      RR(mask0);                                                              \
+      RR(mask1);                                                              \
+      RR(mask2);                                                              \
+      RR(mask3);                                                              \
+    }                                                                         \
+    if (shift >= 16)                                                          \
+    {                                                                         \
+      RR(mask0);                                                              \
+      RR(mask1);                                                              \
+      RR(mask2);                                                              \
+      RR(mask3);                                                              \
+    }                                                                         \
+                                                                              \
+    /* Plot, using foreground mask. */                                        \
+                                                                              \
+    x = MASK(bm0, mask0);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 1)                                                        \
+      *screenptr++ = x;                                                       \
+                                                                              \
+    x = MASK(bm0, mask1);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 2)                                                        \
+      *screenptr++ = x;                                                       \
+                                                                              \
+    x = MASK(bm0, mask2);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 4)                                                        \
+      *screenptr++ = x;                                                       \
+                                                                              \
+    x = MASK(bm0, mask3);                                                     \
+    foremaskptr++;                                                            \
+    state->foreground_mask_pointer = foremaskptr;                             \
+    if ((ENABLES) & 8)                                                        \
+      *screenptr = x;                                                         \
+                                                                              \
+    screenptr += (COLUMNS) - 3;                                               \
+    state->window_buf_pointer = screenptr;                                    \
+  }                                                                           \
+  while (--iters);                                                            \
+}
+
+/**
+ * Defines a row plotter for the shift left case of
+ * masked_sprite_plotter_24_wide, specialised for the mask of enabled columns
+ * ENABLES, in a window COLUMNS wide.
+ */
+#define MASKED_SPRITE_PLOTTER_24_WIDE_LEFT(ENABLES, NAME, COLUMNS)            \
+static void                                                                   \
+masked_sprite_plotter_24_wide_left_##NAME##_##ENABLES(tgestate_t *state,      \
+                                                      uint8_t     shift)      \
+{                                                                             \
+  uint8_t        x;           /* was A */                                     \
+  uint8_t        iters;       /* was B */                                     \
+  const uint8_t *maskptr;     /* was ? */                                     \
+  const uint8_t *bitmapptr;   /* was ? */                                     \
+  const uint8_t *foremaskptr; /* was ? */                                     \
+  uint8_t       *screenptr;   /* was ? */                                     \
+                                                                              \
+  maskptr   = state->mask_pointer;                                            \
+  bitmapptr = state->bitmap_pointer;                                          \
+                                                                              \
+  assert(maskptr   != NULL);                                                  \
+  assert(bitmapptr != NULL);                                                  \
+                                                                              \
+  iters = state->self_E1E2; /* clipped_height & 0xFF */                       \
+  do                                                                          \
+  {                                                                           \
+    /* Note the different variable order to the case above. */                \
+    uint8_t bm0, bm1, bm2, bm3;         /* was E, C, B, D */                  \
+    uint8_t mask0, mask1, mask2, mask3; /* was E', C', B', D' */              \
+    int     carry = 0;                                                        \
+                                                                              \
+    /* Load bitmap bytes into B,C,E. */                                       \
+    bm2 = *bitmapptr++;                                                       \
+    bm1 = *bitmapptr++;                                                       \
+    bm0 = *bitmapptr++;                                                       \
+                                                                              \
+    /* Load mask bytes into B',C',E'. */                                      \
+    mask2 = *maskptr++;                                                       \
+    mask1 = *maskptr++;                                                       \
+    mask0 = *maskptr++;                                                       \
+                                                                              \
+    if (state->sprite_index & sprite_FLAG_FLIP)                               \
+      flip_24_masked_pixels(state, &mask0, &mask1, &mask2, &bm0, &bm1, &bm2); \
+                                                                              \
+    foremaskptr = state->foreground_mask_pointer;                             \
+    screenptr   = state->window_buf_pointer;                                  \
+                                                                              \
+    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);                                   \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+                                                                              \
+    /* Shift bitmap. */                                                       \
+                                                                              \
+    bm3 = 0;                                                                  \
+    SLA(bm0);                                                                 \
+    RL(bm1);                                                                  \
+    RL(bm2);                                                                  \
+    RL(bm3);                                                                  \
+    if (shift >= 8)                                                           \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+      RL(bm3);                                                                \
+    }                                                                         \
+    if (shift >= 16)                                                          \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+      RL(bm3);                                                                \
+    }                                                                         \
+    if (shift >= 24)                                                          \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+      RL(bm3);                                                                \
+    }                                                                         \
+                                                                              \
+    /* Shift mask. */                                                         \
+                                                                              \
+    mask3 = 0xFF;                                                             \
+    carry = 1;                                                                \
+    RL(mask0);                                                                \
+    RL(mask1);                                                                \
+    RL(mask2);                                                                \
+    RL(mask3);                                                                \
+    if (shift >= 8)                                                           \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+      RL(mask3);                                                              \
+    }                                                                         \
+    if (shift >= 16)                                                          \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+      RL(mask3);                                                              \
+    }                                                                         \
+    if (shift >= 24)                                                          \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+      RL(mask3);                                                              \
+    }                                                                         \
+                                                                              \
+    /* Plot, using foreground mask. */                                        \
+                                                                              \
+    x = MASK(bm3, mask3);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 1)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm2, mask2);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 2)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm1, mask1);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 4)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm0, mask0);                                                     \
+    foremaskptr++;                                                            \
+    state->foreground_mask_pointer = foremaskptr;                             \
+    if ((ENABLES) & 8)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    screenptr += (COLUMNS) - 3;                                               \
+    state->window_buf_pointer = screenptr;                                    \
+  }                                                                           \
+  while (--iters);                                                            \
+}
+
+/**
+ * Defines a row plotter for masked_sprite_plotter_16_wide_left, specialised
+ * for the mask of enabled columns ENABLES, in a window COLUMNS wide.
+ */
+#define MASKED_SPRITE_PLOTTER_16_WIDE_LEFT(ENABLES, NAME, COLUMNS)            \
+static void                                                                   \
+masked_sprite_plotter_16_wide_left_##NAME##_##ENABLES(tgestate_t *state,      \
+                                                      uint8_t     shift)      \
+{                                                                             \
+  uint8_t        x;           /* was A */                                     \
+  uint8_t        iters;       /* was B */                                     \
+  const uint8_t *maskptr;     /* was ? */                                     \
+  const uint8_t *bitmapptr;   /* was ? */                                     \
+  const uint8_t *foremaskptr; /* was ? */                                     \
+  uint8_t       *screenptr;   /* was ? */                                     \
+                                                                              \
+  maskptr   = state->mask_pointer;                                            \
+  bitmapptr = state->bitmap_pointer;                                          \
+                                                                              \
+  assert(maskptr   != NULL);                                                  \
+  assert(bitmapptr != NULL);                                                  \
+                                                                              \
+  iters = state->self_E2C2; /* (clipped height & 0xFF) */                     \
+  do                                                                          \
+  {                                                                           \
+    uint8_t bm0, bm1, bm2;       /* was D, E, C */                            \
+    uint8_t mask0, mask1, mask2; /* was D', E', C' */                         \
+    int     carry = 0;                                                        \
+                                                                              \
+    /* Load bitmap bytes into D,E. */                                         \
+    bm0 = *bitmapptr++;                                                       \
+    bm1 = *bitmapptr++;                                                       \
+                                                                              \
+    /* Load mask bytes into D',E'. */                                         \
+    mask0 = *maskptr++;                                                       \
+    mask1 = *maskptr++;                                                       \
+                                                                              \
+    if (state->sprite_index & sprite_FLAG_FLIP)                               \
+      flip_16_masked_pixels(state, &mask0, &mask1, &bm0, &bm1);               \
+                                                                              \
+    foremaskptr = state->foreground_mask_pointer;                             \
+    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);                                   \
+                                                                              \
+    /* Shift mask. */                                                         \
+                                                                              \
+    mask2 = 0xFF; /* all bits set => mask OFF */                              \
+    carry = 1; /* mask OFF */                                                 \
+    RR(mask0);                                                                \
+    RR(mask1);                                                                \
+    RR(mask2);                                                                \
+    if (shift >= 6)                                                           \
+    {                                                                         \
+      RR(mask0);                                                              \
+      RR(mask1);                                                              \
+      RR(mask2);                                                              \
+    }                                                                         \
+    if (shift >= 12)                                                          \
+    {                                                                         \
+      RR(mask0);                                                              \
+      RR(mask1);                                                              \
+      RR(mask2);                                                              \
+    }                                                                         \
+                                                                              \
+    /* Shift bitmap. */                                                       \
+                                                                              \
+    bm2 = 0; /* all bits clear => pixels OFF */                               \
+    SRL(bm0);                                                                 \
+    RR(bm1);                                                                  \
+    RR(bm2);                                                                  \
+    if (shift >= 6)                                                           \
+    {                                                                         \
+      SRL(bm0);                                                               \
+      RR(bm1);                                                                \
+      RR(bm2);                                                                \
+    }                                                                         \
+    if (shift >= 12)                                                          \
+    {                                                                         \
+      SRL(bm0);                                                               \
+      RR(bm1);                                                                \
+      RR(bm2);                                                                \
+    }                                                                         \
+                                                                              \
+    /* Plot, using foreground mask. */                                        \
+                                                                              \
+    screenptr = state->window_buf_pointer;                                    \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+                                                                              \
+    x = MASK(bm0, mask0);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 1)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm1, mask1);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 2)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm2, mask2);                                                     \
+    foremaskptr += 2;                                                         \
+    state->foreground_mask_pointer = foremaskptr;                             \
+    if ((ENABLES) & 4)                                                        \
+      *screenptr = x;                                                         \
+                                                                              \
+    screenptr += (COLUMNS) - 2;                                               \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+    state->window_buf_pointer = screenptr;                                    \
+  }                                                                           \
+  while (--iters);                                                            \
+}
+
+/**
+ * Defines a row plotter for masked_sprite_plotter_16_wide_right, specialised
+ * for the mask of enabled columns ENABLES, in a window COLUMNS wide.
+ */
+#define MASKED_SPRITE_PLOTTER_16_WIDE_RIGHT(ENABLES, NAME, COLUMNS)           \
+static void                                                                   \
+masked_sprite_plotter_16_wide_right_##NAME##_##ENABLES(tgestate_t *state,     \
+                                                       uint8_t     shift)     \
+{                                                                             \
+  uint8_t        x;           /* was A */                                     \
+  uint8_t        iters;       /* was B */                                     \
+  const uint8_t *maskptr;     /* was ? */                                     \
+  const uint8_t *bitmapptr;   /* was ? */                                     \
+  const uint8_t *foremaskptr; /* was ? */                                     \
+  uint8_t       *screenptr;   /* was ? */                                     \
+                                                                              \
+  maskptr   = state->mask_pointer;                                            \
+  bitmapptr = state->bitmap_pointer;                                          \
+                                                                              \
+  assert(maskptr   != NULL);                                                  \
+  assert(bitmapptr != NULL);                                                  \
+                                                                              \
+  iters = state->self_E363; /* (clipped height & 0xFF) */                     \
+  do                                                                          \
+  {                                                                           \
+    /* Note the different variable order to the 'left' case above. */        \
+    uint8_t bm0, bm1, bm2;       /* was E, D, C */                            \
+    uint8_t mask0, mask1, mask2; /* was E', D', C' */                         \
+    int     carry = 0;                                                        \
+                                                                              \
+    /* Load bitmap bytes into D,E. */                                         \
+    bm1 = *bitmapptr++;                                                       \
+    bm0 = *bitmapptr++;                                                       \
+                                                                              \
+    /* Load mask bytes into D',E'. */                                         \
+    mask1 = *maskptr++;                                                       \
+    mask0 = *maskptr++;                                                       \
+                                                                              \
+    if (state->sprite_index & sprite_FLAG_FLIP)                               \
+      flip_16_masked_pixels(state, &mask1, &mask0, &bm1, &bm0);               \
+                                                                              \
+    foremaskptr = state->foreground_mask_pointer;                             \
+    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);                                   \
+                                                                              \
+    /* Shift mask. */                                                         \
+                                                                              \
+    mask2 = 0xFF; /* all bits set => mask OFF */                              \
+    carry = 1; /* mask OFF */                                                 \
+    RL(mask0);                                                                \
+    RL(mask1);                                                                \
+    RL(mask2);                                                                \
+    if (shift >= 6)                                                           \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+    }                                                                         \
+    if (shift >= 12)                                                          \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+    }                                                                         \
+    if (shift >= 18)                                                          \
+    {                                                                         \
+      RL(mask0);                                                              \
+      RL(mask1);                                                              \
+      RL(mask2);                                                              \
+    }                                                                         \
+                                                                              \
+    /* Shift bitmap. */                                                       \
+                                                                              \
+    bm2 = 0; /* all bits clear => pixels OFF */                               \
+    SLA(bm0);                                                                 \
+    RL(bm1);                                                                  \
+    RL(bm2);                                                                  \
+    if (shift >= 6)                                                           \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+    }                                                                         \
+    if (shift >= 12)                                                          \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+    }                                                                         \
+    if (shift >= 18)                                                          \
+    {                                                                         \
+      SLA(bm0);                                                               \
+      RL(bm1);                                                                \
+      RL(bm2);                                                                \
+    }                                                                         \
+                                                                              \
+    /* Plot, using foreground mask. */                                        \
+                                                                              \
+    screenptr = state->window_buf_pointer;                                    \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+                                                                              \
+    x = MASK(bm2, mask2);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 1)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm1, mask1);                                                     \
+    foremaskptr++;                                                            \
+    if ((ENABLES) & 2)                                                        \
+      *screenptr = x;                                                         \
+    screenptr++;                                                              \
+                                                                              \
+    x = MASK(bm0, mask0);                                                     \
+    foremaskptr += 2;                                                         \
+    state->foreground_mask_pointer = foremaskptr;                             \
+    if ((ENABLES) & 4)                                                        \
+      *screenptr = x;                                                         \
+                                                                              \
+    screenptr += (COLUMNS) - 2;                                               \
+    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);                                   \
+    state->window_buf_pointer = screenptr;                                    \
+  }                                                                           \
+  while (--iters);                                                            \
+}
+
+/* ----------------------------------------------------------------------- */
+
+/**
+ * $E0E0: (Formerly) Addresses of self-modified locations which are changed
+ * between NOPs and LD (HL),A.
+ *
+ * Conv: Now tables of row plotters specialised for each mask of enabled
+ * columns. Indexed by masks built by make_masked_sprite_plotter_enables.
  *
  * Used by setup_item_plotting and setup_vischar_plotting. [setup_item_plotting: items are always 16 wide].
  */
-const size_t masked_sprite_plotter_16_enables[2 * 3] =
-{
-  offsetof(tgestate_t, enable_E319),
-  offsetof(tgestate_t, enable_E3C5),
-  offsetof(tgestate_t, enable_E32A),
-  offsetof(tgestate_t, enable_E3D6),
-  offsetof(tgestate_t, enable_E340),
-  offsetof(tgestate_t, enable_E3EC),
+#define MASKED_SPRITE_PLOTTER_ENTRY_16_LEFT(ENABLES, NAME, COLUMNS) \
+  &masked_sprite_plotter_16_wide_left_##NAME##_##ENABLES,
+#define MASKED_SPRITE_PLOTTER_ENTRY_16_RIGHT(ENABLES, NAME, COLUMNS) \
+  &masked_sprite_plotter_16_wide_right_##NAME##_##ENABLES,
+
+/**
+ * $E0EC: (Formerly) Addresses of self-modified locations which are changed
+ * between NOPs and LD (HL),A.
+ *
+ * Conv: As above, but for 24 pixel wide sprites.
+ *
+ * Used by setup_vischar_plotting.
+ */
+#define MASKED_SPRITE_PLOTTER_ENTRY_24_RIGHT(ENABLES, NAME, COLUMNS) \
+  &masked_sprite_plotter_24_wide_right_##NAME##_##ENABLES,
+#define MASKED_SPRITE_PLOTTER_ENTRY_24_LEFT(ENABLES, NAME, COLUMNS) \
+  &masked_sprite_plotter_24_wide_left_##NAME##_##ENABLES,
+
+/**
+ * Conv: Defines every row plotter for a window COLUMNS wide, and the
+ * masked_sprite_plotters_*_NAME tables of them used by renderer_NAME.
+ */
+#define MASKED_SPRITE_PLOTTERS(NAME, COLUMNS)                                 \
+FOR_EACH_ENABLES_24(MASKED_SPRITE_PLOTTER_24_WIDE_RIGHT, NAME, COLUMNS)       \
+FOR_EACH_ENABLES_24(MASKED_SPRITE_PLOTTER_24_WIDE_LEFT, NAME, COLUMNS)        \
+FOR_EACH_ENABLES_16(MASKED_SPRITE_PLOTTER_16_WIDE_LEFT, NAME, COLUMNS)        \
+FOR_EACH_ENABLES_16(MASKED_SPRITE_PLOTTER_16_WIDE_RIGHT, NAME, COLUMNS)       \
+                                                                              \
+static const maskedrowplotter_t masked_sprite_plotters_16_left_##NAME[8] =    \
+{                                                                             \
+  FOR_EACH_ENABLES_16(MASKED_SPRITE_PLOTTER_ENTRY_16_LEFT, NAME, COLUMNS)     \
+};                                                                            \
+                                                                              \
+static const maskedrowplotter_t masked_sprite_plotters_16_right_##NAME[8] =   \
+{                                                                             \
+  FOR_EACH_ENABLES_16(MASKED_SPRITE_PLOTTER_ENTRY_16_RIGHT, NAME, COLUMNS)    \
+};                                                                            \
+                                                                              \
+static const maskedrowplotter_t masked_sprite_plotters_24_right_##NAME[16] =  \
+{                                                                             \
+  FOR_EACH_ENABLES_24(MASKED_SPRITE_PLOTTER_ENTRY_24_RIGHT, NAME, COLUMNS)    \
+};                                                                            \
+                                                                              \
+static const maskedrowplotter_t masked_sprite_plotters_24_left_##NAME[16] =   \
+{                                                                             \
+  FOR_EACH_ENABLES_24(MASKED_SPRITE_PLOTTER_ENTRY_24_LEFT, NAME, COLUMNS)     \
 };
 
-/* ----------------------------------------------------------------------- */
+MASKED_SPRITE_PLOTTERS(24x17, 24)
+MASKED_SPRITE_PLOTTERS(generic, state->columns)
 
-#define MASK(bm,mask) ((~*foremaskptr | (mask)) & *screenptr) | ((bm) & *foremaskptr)
+/**
+ * Build the mask of enabled columns for a clipped sprite.
+ *
+ * Conv: Replaces the loops which wrote NOPs or LD (HL),A into the jump
+ * tables. Bit N of the result is set if column N is plotted.
+ *
+ * Leaf.
+ *
+ * \param[in] instr  Initial instruction: LD (HL),A (0x77) or NOP (0x00).
+ * \param[in] offset Column at which instr toggles.
+ * \param[in] iters  Number of columns: 3 or 4.
+ *
+ * \return Mask of enabled columns.
+ */
+uint8_t make_masked_sprite_plotter_enables(uint8_t instr,
+                                           uint8_t offset,
+                                           uint8_t iters)
+{
+  uint8_t enables; /* Conv: Added. */
+  uint8_t column;  /* Conv: Added. */
+
+  assert(iters == 3 || iters == 4);
+
+  enables = 0;
+  column  = 0;
+  do
+  {
+    if (instr)
+      enables |= 1 << column;
+    column++;
+    if (--offset == 0)
+      instr ^= 0x77; /* Toggle between LD (HL),A and NOP. */
+  }
+  while (--iters);
+
+  return enables;
+}
+
+/* ----------------------------------------------------------------------- */
 
 /**
  * $E102: Sprite plotter for 24-pixel-wide sprites. Used for characters and
  * objects.
  *
+ * Conv: The row loops live in the row plotters selected by
+ * setup_vischar_plotting.
+ *
  * \param[in] state   Pointer to game state.
  * \param[in] vischar Pointer to visible character. (was IY)
  */
 void masked_sprite_plotter_24_wide(tgestate_t *state, vischar_t *vischar)
 {
-  uint8_t        x;           /* was A */
-  uint8_t        iters;       /* was B */
-  const uint8_t *maskptr;     /* was ? */
-  const uint8_t *bitmapptr;   /* was ? */
-  const uint8_t *foremaskptr; /* was ? */
-  uint8_t       *screenptr;   /* was ? */
+  uint8_t x; /* was A */
 
   assert(state   != NULL);
   ASSERT_VISCHAR_VALID(vischar);
 
   if ((x = (vischar->screenpos.x & 7)) < 4)
   {
-    uint8_t self_E161, self_E143;
-
     /* Shift right? */
 
     x = (~x & 3) * 8; // jump table offset (on input, A is 0..3)
 
-    self_E161 = x; // self-modify: jump into mask rotate
-    self_E143 = x; // self-modify: jump into bitmap rotate
-
-    maskptr   = state->mask_pointer;
-    bitmapptr = state->bitmap_pointer;
-
-    assert(maskptr   != NULL);
-    assert(bitmapptr != NULL);
-
-    iters = state->self_E121; // clipped_height & 0xFF
-    do
-    {
-      uint8_t bm0, bm1, bm2, bm3;         // was B, C, E, D
-      uint8_t mask0, mask1, mask2, mask3; // was B', C', E', D'
-      int     carry = 0;
-
-      /* Load bitmap bytes into B,C,E. */
-      bm0 = *bitmapptr++;
-      bm1 = *bitmapptr++;
-      bm2 = *bitmapptr++;
-
-      /* Load mask bytes into B',C',E'. */
-      mask0 = *maskptr++;
-      mask1 = *maskptr++;
-      mask2 = *maskptr++;
-
-      if (state->sprite_index & sprite_FLAG_FLIP)
-        flip_24_masked_pixels(state, &mask2, &mask1, &mask0, &bm2, &bm1, &bm0);
-
-      foremaskptr = state->foreground_mask_pointer;
-      screenptr   = state->window_buf_pointer; // moved compared to the other routines
-
-      ASSERT_MASK_BUF_PTR_VALID(foremaskptr);
-      ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-
-      /* Shift bitmap. */
-
-      bm3 = 0;
-      // Conv: Replaced self-modified goto with if-else chain.
-      if (self_E143 >= 0)
-      {
-        SRL(bm0);
-        RR(bm1);
-        RR(bm2);
-        RR(bm3);
-      }
-      if (self_E143 >= 8)
-      {
-        SRL(bm0);
-        RR(bm1);
-        RR(bm2);
-        RR(bm3);
-      }
-      if (self_E143 >= 16)
-      {
-        SRL(bm0);
-        RR(bm1);
-        RR(bm2);
-        RR(bm3);
-      }
-
-      /* Shift mask. */
-
-      mask3 = 0xFF;
-      carry = 1;
-      // Conv: Replaced self-modified goto with if-else chain.
-      if (self_E161 >= 0)
-      {
-        RR(mask0);
-        RR(mask1);
-        RR(mask2);
-        RR(mask3);
-      }
-      if (self_E161 >= 8)
-      {
-        RR(mask0);
-        RR(mask1);
-        RR(mask2);
-        RR(mask3);
-      }
-      if (self_E161 >= 16)
-      {
-        RR(mask0);
-        RR(mask1);
-        RR(mask2);
-        RR(mask3);
-      }
-
-      /* Plot, using foreground mask. */
-
-      x = MASK(bm0, mask0);
-      foremaskptr++;
-      if (state->enable_E188)
-        *screenptr++ = x;
-
-      x = MASK(bm0, mask1);
-      foremaskptr++;
-      if (state->enable_E199)
-        *screenptr++ = x;
-
-      x = MASK(bm0, mask2);
-      foremaskptr++;
-      if (state->enable_E1AA)
-        *screenptr++ = x;
-
-      x = MASK(bm0, mask3);
-      foremaskptr++;
-      state->foreground_mask_pointer = foremaskptr;
-      if (state->enable_E1BF)
-        *screenptr = x;
-
-      screenptr += state->columns - 3;
-      state->window_buf_pointer = screenptr;
-    }
-    while (--iters);
+    /* Conv: Was self-modified jumps into the mask and bitmap rotates (at
+     * $E161 and $E143). */
+    state->masked_sprite_plotter_24_right(state, x);
   }
   else
   {
-    uint8_t self_E22A, self_E204;
-
     /* Shift left? */
 
     x -= 4; // (on input, A is 4..7)
     x = (x << 3) | (x >> 5); // was 3 x RLCA
 
-    self_E22A = x; // self-modify: jump into mask rotate
-    self_E204 = x; // self-modify: jump into bitmap rotate
-
-    maskptr   = state->mask_pointer;
-    bitmapptr = state->bitmap_pointer;
-
-    assert(maskptr   != NULL);
-    assert(bitmapptr != NULL);
-
-    iters = state->self_E1E2; // clipped_height & 0xFF
-    do
-    {
-      /* Note the different variable order to the case above. */
-      uint8_t bm0, bm1, bm2, bm3;         // was E, C, B, D
-      uint8_t mask0, mask1, mask2, mask3; // was E', C', B', D'
-      int     carry = 0;
-
-      /* Load bitmap bytes into B,C,E. */
-      bm2 = *bitmapptr++;
-      bm1 = *bitmapptr++;
-      bm0 = *bitmapptr++;
-
-      /* Load mask bytes into B',C',E'. */
-      mask2 = *maskptr++;
-      mask1 = *maskptr++;
-      mask0 = *maskptr++;
-
-      if (state->sprite_index & sprite_FLAG_FLIP)
-        flip_24_masked_pixels(state, &mask0, &mask1, &mask2, &bm0, &bm1, &bm2);
-
-      foremaskptr = state->foreground_mask_pointer;
-      screenptr   = state->window_buf_pointer;
-
-      ASSERT_MASK_BUF_PTR_VALID(foremaskptr);
-      ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-
-      /* Shift bitmap. */
-
-      bm3 = 0;
-      // Conv: Replaced self-modified goto with if-else chain.
-      if (self_E204 >= 0)
-      {
-        SLA(bm0);
-        RL(bm1);
-        RL(bm2);
-        RL(bm3);
-      }
-      if (self_E204 >= 8)
-      {
-        SLA(bm0);
-        RL(bm1);
-        RL(bm2);
-        RL(bm3);
-      }
-      if (self_E204 >= 16)
-      {
-        SLA(bm0);
-        RL(bm1);
-        RL(bm2);
-        RL(bm3);
-      }
-      if (self_E204 >= 24)
-      {
-        SLA(bm0);
-        RL(bm1);
-        RL(bm2);
-        RL(bm3);
-      }
-
-      /* Shift mask. */
-
-      mask3 = 0xFF;
-      carry = 1;
-      // Conv: Replaced self-modified goto with if-else chain.
-      if (self_E22A >= 0)
-      {
-        RL(mask0);
-        RL(mask1);
-        RL(mask2);
-        RL(mask3);
-      }
-      if (self_E22A >= 8)
-      {
-        RL(mask0);
-        RL(mask1);
-        RL(mask2);
-        RL(mask3);
-      }
-      if (self_E22A >= 16)
-      {
-        RL(mask0);
-        RL(mask1);
-        RL(mask2);
-        RL(mask3);
-      }
-      if (self_E22A >= 24)
-      {
-        RL(mask0);
-        RL(mask1);
-        RL(mask2);
-        RL(mask3);
-      }
-
-      /* Plot, using foreground mask. */
-
-      x = MASK(bm3, mask3);
-      foremaskptr++;
-      if (state->enable_E259)
-        *screenptr = x;
-      screenptr++;
-
-      x = MASK(bm2, mask2);
-      foremaskptr++;
-      if (state->enable_E26A)
-        *screenptr = x;
-      screenptr++;
-
-      x = MASK(bm1, mask1);
-      foremaskptr++;
-      if (state->enable_E27B)
-        *screenptr = x;
-      screenptr++;
-
-      x = MASK(bm0, mask0);
-      foremaskptr++;
-      state->foreground_mask_pointer = foremaskptr;
-      if (state->enable_E290)
-        *screenptr = x;
-      screenptr++;
-
-      screenptr += state->columns - 3;
-      state->window_buf_pointer = screenptr;
-    }
-    while (--iters);
+    /* Conv: Was self-modified jumps into the mask and bitmap rotates (at
+     * $E22A and $E204). */
+    state->masked_sprite_plotter_24_left(state, x);
   }
 }
 
@@ -11067,129 +11885,14 @@ void masked_sprite_plotter_16_wide(tgestate_t *state, vischar_t *vischar)
  */
 void masked_sprite_plotter_16_wide_left(tgestate_t *state, uint8_t x)
 {
-  uint8_t        iters;       /* was B */
-  const uint8_t *maskptr;     /* was ? */
-  const uint8_t *bitmapptr;   /* was ? */
-  const uint8_t *foremaskptr; /* was ? */
-  uint8_t       *screenptr;   /* was ? */
-  uint8_t        self_E2DC, self_E2F4;
-
   assert(state != NULL);
   // assert(x);
 
   x = (~x & 3) * 6; // jump table offset (on input, A is 0..3 => 3..0) // 6 = length of asm chunk
 
-  self_E2DC = x; // self-modify: jump into mask rotate
-  self_E2F4 = x; // self-modify: jump into bitmap rotate
-
-  maskptr   = state->mask_pointer;
-  bitmapptr = state->bitmap_pointer;
-
-  assert(maskptr   != NULL);
-  assert(bitmapptr != NULL);
-
-  iters = state->self_E2C2; // (clipped height & 0xFF) // self modified by $E49D (setup_vischar_plotting)
-  do
-  {
-    uint8_t bm0, bm1, bm2;       // was D, E, C
-    uint8_t mask0, mask1, mask2; // was D', E', C'
-    int     carry = 0;
-
-    /* Load bitmap bytes into D,E. */
-    bm0 = *bitmapptr++;
-    bm1 = *bitmapptr++;
-
-    /* Load mask bytes into D',E'. */
-    mask0 = *maskptr++;
-    mask1 = *maskptr++;
-
-    if (state->sprite_index & sprite_FLAG_FLIP)
-      flip_16_masked_pixels(state, &mask0, &mask1, &bm0, &bm1);
-
-    // I'm assuming foremaskptr to be a foreground mask pointer based on it being
-    // incremented by four each step, like a supertile wide thing.
-    foremaskptr = state->foreground_mask_pointer;
-    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);
-
-    // 24 version does bitmap rotates then mask rotates.
-    // Is this the opposite way around to save a bank switch?
-
-    /* Shift mask. */
-
-    mask2 = 0xFF; // all bits set => mask OFF (that would match the observed stored mask format)
-    carry = 1; // mask OFF
-    // Conv: Replaced self-modified goto with if-else chain.
-    if (self_E2DC >= 0)
-    {
-      RR(mask0);
-      RR(mask1);
-      RR(mask2);
-    }
-    if (self_E2DC >= 6)
-    {
-      RR(mask0);
-      RR(mask1);
-      RR(mask2);
-    }
-    if (self_E2DC >= 12)
-    {
-      RR(mask0);
-      RR(mask1);
-      RR(mask2);
-    }
-
-    /* Shift bitmap. */
-
-    bm2 = 0; // all bits clear => pixels OFF
-    //carry = 0; in original code but never read in practice
-    // Conv: Replaced self-modified goto with if-else chain.
-    if (self_E2F4 >= 0)
-    {
-      SRL(bm0);
-      RR(bm1);
-      RR(bm2);
-    }
-    if (self_E2F4 >= 6)
-    {
-      SRL(bm0);
-      RR(bm1);
-      RR(bm2);
-    }
-    if (self_E2F4 >= 12)
-    {
-      SRL(bm0);
-      RR(bm1);
-      RR(bm2);
-    }
-
-    /* Plot, using foreground mask. */
-
-    screenptr = state->window_buf_pointer; // moved relative to the 24 version
-    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-
-    x = MASK(bm0, mask0);
-    foremaskptr++;
-    if (state->enable_E319)
-      *screenptr = x;
-    screenptr++;
-
-    x = MASK(bm1, mask1);
-    foremaskptr++;
-    if (state->enable_E32A)
-      *screenptr = x;
-    screenptr++;
-
-    x = MASK(bm2, mask2);
-    foremaskptr += 2;
-    state->foreground_mask_pointer = foremaskptr;
-    if (state->enable_E340)
-      *screenptr = x;
-
-    screenptr += state->columns - 2;
-    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-    state->window_buf_pointer = screenptr;
-  }
-  while (--iters);
+  /* Conv: Was self-modified jumps into the mask and bitmap rotates (at
+   * $E2DC and $E2F4). */
+  state->masked_sprite_plotter_16_left(state, x);
 }
 
 /**
@@ -11202,137 +11905,36 @@ void masked_sprite_plotter_16_wide_left(tgestate_t *state, uint8_t x)
  */
 void masked_sprite_plotter_16_wide_right(tgestate_t *state, uint8_t x)
 {
-  uint8_t        iters;       /* was B */
-  const uint8_t *maskptr;     /* was ? */
-  const uint8_t *bitmapptr;   /* was ? */
-  const uint8_t *foremaskptr; /* was ? */
-  uint8_t       *screenptr;   /* was ? */
-  uint8_t        self_E39A, self_E37D;
-
   assert(state != NULL);
   // assert(x);
 
   x = (x - 4) * 6; // jump table offset (on input, 'x' is 4..7 => 0..3) // 6 = length of asm chunk
 
-  self_E39A = x; // self-modify: jump into bitmap rotate
-  self_E37D = x; // self-modify: jump into mask rotate
-
-  maskptr   = state->mask_pointer;
-  bitmapptr = state->bitmap_pointer;
-
-  assert(maskptr   != NULL);
-  assert(bitmapptr != NULL);
-
-  iters = state->self_E363; // (clipped height & 0xFF) // self modified by $E49D (setup_vischar_plotting)
-  do
-  {
-    /* Note the different variable order to the 'left' case above. */
-    uint8_t bm0, bm1, bm2;       // was E, D, C
-    uint8_t mask0, mask1, mask2; // was E', D', C'
-    int     carry = 0;
-
-    /* Load bitmap bytes into D,E. */
-    bm1 = *bitmapptr++;
-    bm0 = *bitmapptr++;
-
-    /* Load mask bytes into D',E'. */
-    mask1 = *maskptr++;
-    mask0 = *maskptr++;
-
-    if (state->sprite_index & sprite_FLAG_FLIP)
-      flip_16_masked_pixels(state, &mask1, &mask0, &bm1, &bm0);
-
-    foremaskptr = state->foreground_mask_pointer;
-    ASSERT_MASK_BUF_PTR_VALID(foremaskptr);
-
-    /* Shift mask. */
-
-    mask2 = 0xFF; // all bits set => mask OFF (that would match the observed stored mask format)
-    carry = 1; // mask OFF
-    // Conv: Replaced self-modified goto with if-else chain.
-    if (self_E39A >= 0)
-    {
-      RL(mask0);
-      RL(mask1);
-      RL(mask2);
-    }
-    if (self_E39A >= 6)
-    {
-      RL(mask0);
-      RL(mask1);
-      RL(mask2);
-    }
-    if (self_E39A >= 12)
-    {
-      RL(mask0);
-      RL(mask1);
-      RL(mask2);
-    }
-    if (self_E39A >= 18)
-    {
-      RL(mask0);
-      RL(mask1);
-      RL(mask2);
-    }
-
-    /* Shift bitmap. */
-
-    bm2 = 0; // all bits clear => pixels OFF
-    // no carry reset in this variant?
-    if (self_E37D >= 0)
-    {
-      SLA(bm0);
-      RL(bm1);
-      RL(bm2);
-    }
-    if (self_E37D >= 6)
-    {
-      SLA(bm0);
-      RL(bm1);
-      RL(bm2);
-    }
-    if (self_E37D >= 12)
-    {
-      SLA(bm0);
-      RL(bm1);
-      RL(bm2);
-    }
-    if (self_E37D >= 18)
-    {
-      SLA(bm0);
-      RL(bm1);
-      RL(bm2);
-    }
-
-    /* Plot, using foreground mask. */
-
-    screenptr = state->window_buf_pointer; // this line is moved relative to the 24 version
-    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-
-    x = MASK(bm2, mask2);
-    foremaskptr++;
-    if (state->enable_E3C5)
-      *screenptr = x;
-    screenptr++;
+  /* Conv: Was self-modified jumps into the mask and bitmap rotates (at
+   * $E39A and $E37D). */
+  state->masked_sprite_plotter_16_right(state, x);
+}
 
-    x = MASK(bm1, mask1);
-    foremaskptr++;
-    if (state->enable_E3D6)
-      *screenptr = x;
-    screenptr++;
+/* Conv: Generate the bit-reversed bytes in order, two bits at a time. */
+#define R2(n)     (n),  (n) + 2 * 64,  (n) + 1 * 64,  (n) + 3 * 64
+#define R4(n) R2(n), R2((n) + 2 * 16), R2((n) + 1 * 16), R2((n) + 3 * 16)
+#define R6(n) R4(n), R4((n) + 2 *  4), R4((n) + 1 *  4), R4((n) + 3 *  4)
 
-    x = MASK(bm0, mask0);
-    foremaskptr += 2;
-    state->foreground_mask_pointer = foremaskptr;
-    if (state->enable_E3EC)
-      *screenptr = x;
+/**
+ * $7F00: A table of 256 bit-reversed bytes.
+ *
+ * Read by flip_16_masked_pixels and flip_24_masked_pixels only.
+ *
+ * Conv: The original game constructs this at startup. It's constant here.
+ */
+static const uint8_t reversed[256] =
+{
+  R6(0), R6(2), R6(1), R6(3)
+};
 
-    screenptr += state->columns - 2;
-    ASSERT_WINDOW_BUF_PTR_VALID(screenptr);
-    state->window_buf_pointer = screenptr;
-  }
-  while (--iters);
-}
+#undef R6
+#undef R4
+#undef R2
 
 /**
  * $E3FA: Reverses the 24 pixels in E,C,B and E',C',B'.
@@ -11366,7 +11968,7 @@ void flip_24_masked_pixels(tgestate_t *state,
 
   /* Conv: Routine was much simplified over the original code. */
 
-  HL = &state->reversed[0];
+  HL = &reversed[0];
 
   B = HL[*pE];
   E = HL[*pB];
@@ -11409,7 +12011,7 @@ void flip_16_masked_pixels(tgestate_t *state,
   assert(pDdash != NULL);
   assert(pEdash != NULL);
 
-  HL = &state->reversed[0];
+  HL = &reversed[0];
 
   D = HL[*pE];
   E = HL[*pD];
@@ -11436,27 +12038,6 @@ void flip_16_masked_pixels(tgestate_t *state,
  */
 int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
 {
-  /**
-   * $E0EC: Addresses of self-modified locations which are changed between
-   * NOPs and LD (HL),A.
-   */
-  static const size_t masked_sprite_plotter_24_enables[4 * 2] =
-  {
-    offsetof(tgestate_t, enable_E188),
-    offsetof(tgestate_t, enable_E259),
-    offsetof(tgestate_t, enable_E199),
-    offsetof(tgestate_t, enable_E26A),
-    offsetof(tgestate_t, enable_E1AA),
-    offsetof(tgestate_t, enable_E27B),
-    offsetof(tgestate_t, enable_E1BF),
-    offsetof(tgestate_t, enable_E290),
-
-    /* These two addresses are present here in the original game but are
-     * unreferenced. */
-    // masked_sprite_plotter_16_wide
-    // masked_sprite_plotter_24_wide
-  };
-
   pos_t             *pos;            /* was HL */
   tinypos_t         *tinypos;        /* was DE */
   const spritedef_t *sprite;         /* was BC */
@@ -11464,11 +12045,9 @@ int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
   const spritedef_t *sprite2;        /* was DE */
   uint16_t           clipped_width;  /* was BC */
   uint16_t           clipped_height; /* was DE */
-  const size_t      *enables;        /* was HL */
+  uint8_t            enables;        /* was HL */
   uint8_t            self_E4C0;      /* was $E4C0 */
   uint8_t            offset;         /* was A' */
-  uint8_t            Cdash;          /* was C' */
-  uint8_t            iters;          /* was B' */
   uint8_t            E;              /* was E */
   uint8_t            instr;          /* was A */
   uint8_t            A;              /* was A */
@@ -11536,7 +12115,6 @@ int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
     state->self_E363 = E; // self-modify masked_sprite_plotter_16_wide_right
 
     A = 3;
-    enables = &masked_sprite_plotter_16_enables[0];
   }
   else
   {
@@ -11544,7 +12122,6 @@ int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
     state->self_E1E2 = E; // self-modify masked_sprite_plotter_24_wide (shift left case)
 
     A = 4;
-    enables = &masked_sprite_plotter_24_enables[0];
   }
 
   // PUSH HL
@@ -11565,17 +12142,20 @@ int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
 
   // POP HLdash // entry point
 
-  /* Set the addresses in the jump table to NOP or LD (HL),A. */
-  Cdash = offset; // must be no of columns?
-  iters = self_E4C0; /* 3 or 4 iterations */
-  do
+  /* Conv: The original set the addresses in the jump table to NOP or
+   * LD (HL),A. Instead select row plotters specialised for the enabled
+   * columns. */
+  enables = make_masked_sprite_plotter_enables(instr, offset, self_E4C0);
+  if (self_E4C0 == 3)
   {
-    *(((uint8_t *) state) + *enables++) = instr;
-    *(((uint8_t *) state) + *enables++) = instr;
-    if (--offset == 0)
-      instr ^= 0x77; /* Toggle between LD and NOP. */
+    state->masked_sprite_plotter_16_left  = state->renderer->masked_sprite_plotters_16_left[enables];
+    state->masked_sprite_plotter_16_right = state->renderer->masked_sprite_plotters_16_right[enables];
+  }
+  else
+  {
+    state->masked_sprite_plotter_24_right = state->renderer->masked_sprite_plotters_24_right[enables];
+    state->masked_sprite_plotter_24_left  = state->renderer->masked_sprite_plotters_24_left[enables];
   }
-  while (--iters);
 
   y = 0; /* Conv: Moved. */
   if ((clipped_height >> 8) == 0)
@@ -11586,7 +12166,12 @@ int setup_vischar_plotting(tgestate_t *state, vischar_t *vischar)
   state->window_buf_pointer = &state->window_buf[x + y]; // screen buffer start address
   ASSERT_WINDOW_BUF_PTR_VALID(state->window_buf_pointer);
 
-  maskbuf = &state->mask_buffer[0];
+  mark_window_buf_dirty(state,
+                        state->window_buf_pointer,
+                        self_E4C0,
+                        clipped_height & 0xFF);
+
+  maskbuf = &state->mask_buffer.bytes[0];
 
   // POP DE  // get clipped_height
   // PUSH DE
@@ -11695,16 +12280,91 @@ void divide_by_8(uint8_t *plow, uint8_t *phigh)
 /* ----------------------------------------------------------------------- */
 
 /**
- * $EED3: Plot the game screen.
+ * Conv: Mark a rectangle of window_buf as changed so that the next
+ * plot_game_window copies it to the screen.
+ *
+ * The body of mark_window_buf_dirty for each renderer. The division by a
+ * constant column count becomes a multiply in the fixed size renderer.
+ *
+ * \param[in] state   Pointer to game state.
+ * \param[in] p       Pointer to top left of rectangle in window_buf.
+ * \param[in] width   Width in bytes.
+ * \param[in] height  Height in scanlines.
+ * \param[in] columns Columns in the window.
+ * \param[in] rows    Rows in the window.
+ */
+static ALWAYS_INLINE void mark_window_buf_dirty_common(tgestate_t    *state,
+                                                       const uint8_t *p,
+                                                       int            width,
+                                                       int            height,
+                                                       int            columns,
+                                                       int            rows)
+{
+  ptrdiff_t offset;
+  int       x;
+  int       row;
+  int       last_row;
+  uint32_t  mask;
+
+  assert(state != NULL);
+  ASSERT_WINDOW_BUF_PTR_VALID(p);
+  assert(width > 0);
+
+  if (height <= 0)
+    return;
+
+  offset   = p - state->window_buf;
+  x        = (int) (offset % columns);
+  row      = (int) (offset / columns) / 8;
+  last_row = (int) (offset / columns + height - 1) / 8;
+  if (last_row >= rows)
+    last_row = rows - 1;
+
+  if (x + width > columns)
+    mask = ~0u; /* Wraps onto the next scanline. */
+  else
+    mask = ((1u << width) - 1) << x;
+
+  for (; row <= last_row; row++)
+    state->window_buf_dirty[row] |= mask;
+}
+
+/**
+ * Conv: Mark all of window_buf as changed, e.g. after the game window on
+ * screen was drawn over by something else.
  *
  * \param[in] state Pointer to game state.
  */
-void plot_game_window(tgestate_t *state)
+void invalidate_game_window(tgestate_t *state)
+{
+  assert(state != NULL);
+
+  memset(state->window_buf_dirty, 0xFF, sizeof(state->window_buf_dirty));
+}
+
+/**
+ * $EED3: Plot the game screen.
+ *
+ * Conv: Only scanlines whose source tiles in window_buf are marked dirty are
+ * copied. The dirty bits are cleared afterwards. This is the body of
+ * plot_game_window for each renderer.
+ *
+ * \param[in] state   Pointer to game state.
+ * \param[in] columns Columns in the window. (Conv: added)
+ * \param[in] rows    Rows in the window. (Conv: added)
+ */
+static ALWAYS_INLINE void plot_game_window_common(tgestate_t *state,
+                                                  int         columns,
+                                                  int         rows)
 {
   assert(state != NULL);
 
   uint8_t *const  screen = &state->speccy->screen[0];
 
+  uint32_t        dirty_rows; /* Conv: rows with dirty columns 1 onwards */
+  uint32_t        dirty_left; /* Conv: rows with dirty column 0 */
+  int             line;       /* Conv: window_buf scanline */
+  int             row;
   uint8_t         y;         /* was A */
   uint8_t        *src;       /* was HL */
   const uint16_t *offsets;   /* was SP */
@@ -11716,42 +12376,51 @@ void plot_game_window(tgestate_t *state)
   uint8_t         copy;      /* was C */
   uint8_t         tmp;       /* added for RRD macro */
 
+  /* A change of scroll offset moves everything. */
+  if (state->game_window_offset.x != state->window_buf_plotted_offset.x ||
+      state->game_window_offset.y != state->window_buf_plotted_offset.y)
+  {
+    invalidate_game_window(state);
+    state->window_buf_plotted_offset = state->game_window_offset;
+  }
+
+  dirty_rows = 0;
+  dirty_left = 0;
+  for (row = 0; row < rows; row++)
+  {
+    if (state->window_buf_dirty[row] & ~1u)
+      dirty_rows |= 1u << row;
+    if (state->window_buf_dirty[row] & 1u)
+      dirty_left |= 1u << row;
+  }
+  memset(state->window_buf_dirty, 0, sizeof(state->window_buf_dirty));
+
+  if (dirty_rows == 0 && dirty_left == 0)
+    return;
+
+  line = state->game_window_offset.x / columns;
+
   y = state->game_window_offset.y;
   if (y == 0)
   {
     src = &state->window_buf[1] + state->game_window_offset.x;
     ASSERT_WINDOW_BUF_PTR_VALID(src);
     offsets = &state->game_window_start_offsets[0];
-    y_iters_A = 128; /* iterations */
+    y_iters_A = (rows - 1) * 8; /* iterations */ /* was 128 */
     do
     {
       dst = screen + *offsets++;
       ASSERT_SCREEN_PTR_VALID(dst);
 
-      *dst++ = *src++; /* unrolled: 23 copies */
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      src++; // skip 24th
+      if ((dirty_rows & (1u << (line++ / 8))) == 0)
+      {
+        src += columns; /* Conv: Clean. Skip this scanline. */
+        continue;
+      }
+
+      /* Conv: Was 23 unrolled copies then a skip of the 24th byte. */
+      memcpy(dst, src, columns - 1);
+      src += columns;
     }
     while (--y_iters_A);
   }
@@ -11761,7 +12430,7 @@ void plot_game_window(tgestate_t *state)
     ASSERT_WINDOW_BUF_PTR_VALID(src);
     data = *src++;
     offsets = &state->game_window_start_offsets[0];
-    y_iters_B = 128; /* iterations */
+    y_iters_B = (rows - 1) * 8; /* iterations */ /* was 128 */
     do
     {
       dst = screen + *offsets++;
@@ -11773,8 +12442,19 @@ void plot_game_window(tgestate_t *state)
   A = (*HL & 0x0F) | (A & 0xF0); \
   *HL = (*HL >> 4) | (tmp << 4);
 
+      /* Conv: Each scanline also reads the first byte of the next. */
+      if ((dirty_rows & (1u << (line / 8))) == 0 &&
+          (dirty_left & (1u << ((line + 1) / 8))) == 0)
+      {
+        line++;
+        src += columns - 1; /* Conv: Clean. Skip this scanline. */
+        data = *src++;
+        continue;
+      }
+      line++;
+
       /* Conv: Unrolling removed compared to original code which did 4 groups of 5 ops, then a final 3. */
-      iters = 4 * 5 + 3; /* iterations */
+      iters = columns - 1; /* iterations */ /* was 4 * 5 + 3 */
       do
       {
         copy = *src; // safe copy of source data
@@ -11798,6 +12478,172 @@ void plot_game_window(tgestate_t *state)
 
 /* ----------------------------------------------------------------------- */
 
+/**
+ * Conv: Defines the renderer_NAME table of rendering routines for a game
+ * window of COLUMNS by ROWS tiles over ST_COLUMNS by ST_ROWS supertiles.
+ *
+ * Each routine expands its body with the dimensions given. When they are
+ * constants the strides, loop counts and divisions fold into immediates.
+ */
+#define RENDERER(NAME, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS)                    \
+static void get_supertiles_##NAME(tgestate_t *state)                          \
+{                                                                             \
+  get_supertiles_common(state, ST_COLUMNS, ST_ROWS);                          \
+}                                                                             \
+                                                                              \
+static void plot_interior_tiles_##NAME(tgestate_t *state)                     \
+{                                                                             \
+  plot_interior_tiles_common(state, COLUMNS, ROWS);                           \
+}                                                                             \
+                                                                              \
+static void plot_all_tiles_##NAME(tgestate_t *state)                          \
+{                                                                             \
+  plot_all_tiles_common(state, COLUMNS, ROWS, ST_COLUMNS);                    \
+}                                                                             \
+                                                                              \
+static void shunt_map_left_##NAME(tgestate_t *state)                          \
+{                                                                             \
+  shunt_map_left_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);           \
+}                                                                             \
+                                                                              \
+static void shunt_map_right_##NAME(tgestate_t *state)                         \
+{                                                                             \
+  shunt_map_right_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);          \
+}                                                                             \
+                                                                              \
+static void shunt_map_up_right_##NAME(tgestate_t *state)                      \
+{                                                                             \
+  shunt_map_up_right_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);       \
+}                                                                             \
+                                                                              \
+static void shunt_map_up_##NAME(tgestate_t *state)                            \
+{                                                                             \
+  shunt_map_up_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);             \
+}                                                                             \
+                                                                              \
+static void shunt_map_down_##NAME(tgestate_t *state)                          \
+{                                                                             \
+  shunt_map_down_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);           \
+}                                                                             \
+                                                                              \
+static void shunt_map_down_left_##NAME(tgestate_t *state)                     \
+{                                                                             \
+  shunt_map_down_left_common(state, COLUMNS, ROWS, ST_COLUMNS, ST_ROWS);      \
+}                                                                             \
+                                                                              \
+static void mark_window_buf_dirty_##NAME(tgestate_t    *state,                \
+                                         const uint8_t *p,                    \
+                                         int            width,                \
+                                         int            height)               \
+{                                                                             \
+  mark_window_buf_dirty_common(state, p, width, height, COLUMNS, ROWS);       \
+}                                                                             \
+                                                                              \
+static void plot_game_window_##NAME(tgestate_t *state)                        \
+{                                                                             \
+  plot_game_window_common(state, COLUMNS, ROWS);                              \
+}                                                                             \
+                                                                              \
+const tgerenderer_t renderer_##NAME =                                         \
+{                                                                             \
+  &get_supertiles_##NAME,                                                     \
+  &plot_interior_tiles_##NAME,                                                \
+  &plot_all_tiles_##NAME,                                                     \
+  &shunt_map_left_##NAME,                                                     \
+  &shunt_map_right_##NAME,                                                    \
+  &shunt_map_up_right_##NAME,                                                 \
+  &shunt_map_up_##NAME,                                                       \
+  &shunt_map_down_##NAME,                                                     \
+  &shunt_map_down_left_##NAME,                                                \
+  &mark_window_buf_dirty_##NAME,                                              \
+  &plot_game_window_##NAME,                                                   \
+  &masked_sprite_plotters_16_left_##NAME[0],                                  \
+  &masked_sprite_plotters_16_right_##NAME[0],                                 \
+  &masked_sprite_plotters_24_right_##NAME[0],                                 \
+  &masked_sprite_plotters_24_left_##NAME[0],                                  \
+};
+
+/**
+ * Conv: Renderer for the standard 24x17 window buffer over 7x5 supertiles.
+ */
+RENDERER(24x17, 24, 17, 7, 5)
+
+/**
+ * Conv: Renderer for any other window size. Reads the dimensions from the
+ * state.
+ *
+ * tge_create picks this only when COLUMNS, ROWS, ST_COLUMNS or ST_ROWS in
+ * Create.c differ from the standard 24x17 over 7x5, so the game as built
+ * always uses renderer_24x17. Other sizes also need game_window_start_offsets
+ * and the window's position on screen reworked.
+ */
+RENDERER(generic, state->columns, state->rows, state->st_columns, state->st_rows)
+
+/* ----------------------------------------------------------------------- */
+
+/* Conv: These entry points call the routines of the renderer chosen for the
+ * window size by tge_create. */
+
+void get_supertiles(tgestate_t *state)
+{
+  state->renderer->get_supertiles(state);
+}
+
+void plot_interior_tiles(tgestate_t *state)
+{
+  state->renderer->plot_interior_tiles(state);
+}
+
+void plot_all_tiles(tgestate_t *state)
+{
+  state->renderer->plot_all_tiles(state);
+}
+
+void shunt_map_left(tgestate_t *state)
+{
+  state->renderer->shunt_map_left(state);
+}
+
+void shunt_map_right(tgestate_t *state)
+{
+  state->renderer->shunt_map_right(state);
+}
+
+void shunt_map_up_right(tgestate_t *state)
+{
+  state->renderer->shunt_map_up_right(state);
+}
+
+void shunt_map_up(tgestate_t *state)
+{
+  state->renderer->shunt_map_up(state);
+}
+
+void shunt_map_down(tgestate_t *state)
+{
+  state->renderer->shunt_map_down(state);
+}
+
+void shunt_map_down_left(tgestate_t *state)
+{
+  state->renderer->shunt_map_down_left(state);
+}
+
+void mark_window_buf_dirty(tgestate_t    *state,
+                           const uint8_t *p,
+                           int            width,
+                           int            height)
+{
+  state->renderer->mark_window_buf_dirty(state, p, width, height);
+}
+
+void plot_game_window(tgestate_t *state)
+{
+  state->renderer->plot_game_window(state);
+}
+
+/* ----------------------------------------------------------------------- */
+
 /**
  * $EF9A: Event: roll call.
  *
@@ -11927,11 +12773,11 @@ int user_confirm(tgestate_t *state)
   /* Keyscan. */
   for (;;)
   {
-    keymask = state->speccy->in(state->speccy, port_KEYBOARD_POIUY);
+    keymask = zxinput_read(&state->speccy->input, port_KEYBOARD_POIUY);
     if ((keymask & (1 << 4)) == 0)
       return 0; /* is 'Y' pressed? return Z */
 
-    keymask = state->speccy->in(state->speccy, port_KEYBOARD_SPACESYMSHFTMNB);
+    keymask = zxinput_read(&state->speccy->input, port_KEYBOARD_SPACESYMSHFTMNB);
     keymask = ~keymask;
     if ((keymask & (1 << 3)) != 0)
       return 1; /* is 'N' pressed? return NZ */
@@ -11955,10 +12801,10 @@ TGE_API void tge_setup(tgestate_t *state)
    * The original game stores just 23 bytes of the structure, we store a
    * whole structure here.
    *
-   * This can't be a _static_ const structure as it contains references which
-   * are not compile time constant.
+   * Conv: Static, so its padding is zero and every instance's characters
+   * start out byte for byte the same.
    */
-  const vischar_t vischar_initial =
+  static const vischar_t vischar_initial =
   {
     0x00,                 // character
     0x00,                 // flags
@@ -11966,7 +12812,7 @@ TGE_API void tge_setup(tgestate_t *state)
     { 0x2E, 0x2E, 0x18 }, // p04
     0x00,                 // counter_and_flags
     &animations[0],       // animbase
-    animations[8],        // anim
+    anim_I,               // anim (== animations[8])
     0x00,                 // b0C
     0x00,                 // input
     direction_TOP_LEFT,   // direction
@@ -11979,48 +12825,35 @@ TGE_API void tge_setup(tgestate_t *state)
     0x00,                 // height
   };
 
-  uint8_t   *reversed; /* was HL */
-  uint8_t    counter;  /* was A */
-  uint8_t    byte;     /* was C */
   uint8_t    iters;    /* was B */
-  int        carry = 0;
   vischar_t *vischar;  /* was HL */
 
   assert(state != NULL);
 
   wipe_full_screen_and_attributes(state);
   set_morale_flag_screen_attributes(state, attribute_BRIGHT_GREEN_OVER_BLACK);
-  /* The original code seems to pass in 0x44, not zero, as it uses a register
-   * left over from a previous call to set_morale_flag_screen_attributes(). */
-  set_menu_item_attributes(state, 0, attribute_BRIGHT_YELLOW_OVER_BLACK);
-  plot_statics_and_menu_text(state);
-
-  plot_score(state);
-
-  menu_screen(state);
-
-
-  /* Construct a table of 256 bit-reversed bytes at 0x7F00. */
-  reversed = &state->reversed[0];
-  do
+  if (state->cold.skip_menu)
+  {
+    /* Conv: Added. The input device and keys were chosen at creation. */
+    plot_statics(state);
+    plot_score(state);
+  }
+  else
   {
-    /* This was 'A = L;' in original code as alignment was guaranteed. */
-    counter = reversed - &state->reversed[0]; /* Get a counter 0..255. */
+    /* The original code seems to pass in 0x44, not zero, as it uses a
+     * register left over from a previous call to
+     * set_morale_flag_screen_attributes(). */
+    set_menu_item_attributes(state, 0, attribute_BRIGHT_YELLOW_OVER_BLACK);
+    plot_statics_and_menu_text(state);
 
-    /* Reverse the counter byte. */
-    byte = 0;
-    iters = 8;
-    do
-    {
-      carry = counter & 1;
-      counter >>= 1;
-      byte = (byte << 1) | carry;
-    }
-    while (--iters);
+    plot_score(state);
 
-    *reversed++ = byte;
+    menu_screen(state);
   }
-  while (reversed != &state->reversed[256]); // was ((HL & 0xFF) != 0);
+
+
+  /* Conv: The original game constructs a table of 256 bit-reversed bytes
+   * at $7F00 here. It's a constant table in this version. */
 
   /* Initialise all visible characters. */
   vischar = &state->vischars[0];
@@ -12057,16 +12890,43 @@ TGE_API void tge_setup(tgestate_t *state)
     //enter_room(state); // returns by goto main_loop
     NEVER_RETURNS;
   }
+
+  /* Conv: Keep the state from here on for tge_reset. */
+  capture_template(state);
+}
+
+TGE_API void tge_set_render_interval(tgestate_t *state, int interval)
+{
+  assert(state != NULL);
+  assert(interval >= 0);
+
+  state->render_interval  = interval;
+  state->render_countdown = 0; /* render the next frame */
+}
+
+TGE_API void tge_request_render(tgestate_t *state)
+{
+  assert(state != NULL);
+
+  state->render_requested = 1;
 }
 
 TGE_API void tge_main(tgestate_t *state)
 {
+  /* Conv: The game is paused while the zoombox opens. */
+  if (state->zoombox.opening)
+  {
+    (void) zoombox_step(state);
+    state->speccy->end_frame(state->speccy);
+    return;
+  }
+
   // Conv: Need to get main loop to setjmp so we call it from here.
   if (setjmp(state->jmpbuf_main) == 0)
   {
     main_loop(state);
 
-    state->speccy->kick(state->speccy); // temporary
+    state->speccy->end_frame(state->speccy);
   }
 }
 
@@ -12087,6 +12947,8 @@ void wipe_full_screen_and_attributes(tgestate_t *state)
          attribute_WHITE_OVER_BLACK,
          SCREEN_ATTRIBUTES_LENGTH);
 
+  invalidate_game_window(state);
+
   /* Set the screen border to black. */
   state->speccy->out(state->speccy, port_BORDER, 0);
 }
@@ -0,0 +1,48 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdint.h>
+
+#include "TheGreatEscape/Map.h"
+#include "TheGreatEscape/SuperTiles.h"
+#include "TheGreatEscape/Tiles.h"
+#include "TheGreatEscape/Types.h"
+
+/**
+ * A mask decoded into a plain width by height array of mask tile indices.
+ */
+typedef struct expandedmask
+{
+  uint32_t offset;  /**< Offset of the tile indices from the first mask. */
+  uint8_t  width;
+  uint8_t  height;
+  uint16_t unused;
+}
+expandedmask_t;
+
+/**
+ * Conv: Added. The graphics and level data read while rendering.
+ *
+ * These point either to the compiled-in arrays or into a mapped asset pack.
+ */
+typedef struct tgeassets
+{
+  const tile_t           *mask_tiles;
+  const tile_t           *exterior_tiles[3]; /**< Sets 1 to 3. Each may be
+                                                   indexed into the next. */
+  const tile_t           *interior_tiles;
+  const supertile_t      *supertiles;
+  const supertileindex_t *map;
+  const mask_t           *exterior_mask_data;
+
+  /** Masks indexed like mask_pointers, or NULL to decode those instead. */
+  const expandedmask_t   *masks;
+}
+tgeassets_t;
+
+/**
+ * The assets in use by all instances in the process.
+ */
+extern const tgeassets_t *assets;
+
+#endif /* ASSETS_H */
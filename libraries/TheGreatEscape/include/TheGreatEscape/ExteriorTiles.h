@@ -4,9 +4,7 @@
 #include "TheGreatEscape/Tiles.h"
 
 extern const tile_t mask_tiles[111];
-extern const tile_t exterior_tiles_1[145];
-extern const tile_t exterior_tiles_2[220];
-extern const tile_t exterior_tiles_3[206];
+extern const tile_t exterior_tiles[exterior_tiles__LIMIT];
 
 #endif /* EXTERIOR_TILES_H */
 
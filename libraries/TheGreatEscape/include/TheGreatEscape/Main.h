@@ -28,8 +28,8 @@ do {                                                  \
 
 #define ASSERT_MASK_BUF_PTR_VALID(p)                  \
 do {                                                  \
-  assert(p >= &state->mask_buffer[0]);                \
-  assert(p < &state->mask_buffer[5 * MASK_BUFFER_WIDTH]); \
+  assert(p >= &state->mask_buffer.bytes[0]);          \
+  assert(p < &state->mask_buffer.bytes[MASK_BUFFER_LENGTH]); \
 } while (0)
 
 #define ASSERT_TILE_BUF_PTR_VALID(p)                  \
@@ -73,10 +73,10 @@ do {                                                          \
   assert(i >= 0 && i < item__LIMIT);                          \
 } while (0)
 
-#define ASSERT_INTERIOR_TILES_VALID(p)                                \
-do {                                                                  \
-  assert(p >= &interior_tiles[0].row[0]);                             \
-  assert(p <= &interior_tiles[interiorobjecttile__LIMIT - 1].row[0]); \
+#define ASSERT_INTERIOR_TILES_VALID(p)                                        \
+do {                                                                          \
+  assert(p >= &assets->interior_tiles[0].row[0]);                             \
+  assert(p <= &assets->interior_tiles[interiorobjecttile__LIMIT - 1].row[0]); \
 } while (0)
 
 #define ASSERT_DOORS_VALID(p)                                 \
@@ -85,16 +85,16 @@ do {                                                          \
   assert(p < &state->doors[4]);                               \
 } while (0)
 
-#define ASSERT_SUPERTILE_PTR_VALID(p)                           \
-do {                                                            \
-  assert(p >= &supertiles[0].tiles[0]);                         \
-  assert(p <= &supertiles[supertileindex__LIMIT - 1].tiles[0]); \
+#define ASSERT_SUPERTILE_PTR_VALID(p)                                   \
+do {                                                                    \
+  assert(p >= &assets->supertiles[0].tiles[0]);                         \
+  assert(p <= &assets->supertiles[supertileindex__LIMIT - 1].tiles[0]); \
 } while (0)
 
 #define ASSERT_MAP_PTR_VALID(p)                               \
 do {                                                          \
-  assert(p >= &map[0]);                                       \
-  assert(p < &map[MAPX * MAPY]);                              \
+  assert(p >= &assets->map[0]);                               \
+  assert(p < &assets->map[MAPX * MAPY]);                      \
 } while (0)
 
 // These limits were determined by checking the original game and cover the main map only. They'll need adjusting.
@@ -114,6 +114,16 @@ do {                                                          \
 
 #define INLINE __inline
 
+/* Conv: Added. Always inlined, so that constant arguments fold into the
+ * body. Used to expand the renderer bodies. */
+#if defined(__GNUC__)
+#define ALWAYS_INLINE __inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define ALWAYS_INLINE __forceinline
+#else
+#define ALWAYS_INLINE __inline
+#endif
+
 /* $6000 onwards */
 
 void transition(tgestate_t      *state,
@@ -142,8 +152,6 @@ void expand_object(tgestate_t *state, object_t index, uint8_t *output);
 
 void plot_interior_tiles(tgestate_t *state);
 
-extern uint8_t *const beds[beds_LENGTH];
-
 /* $7000 onwards */
 
 extern /*const*/ doorpos_t door_positions[door_MAX * 2];
@@ -179,11 +187,18 @@ void screen_wipe(tgestate_t *state,
 
 uint8_t *get_next_scanline(tgestate_t *state, uint8_t *slp);
 
+uint8_t *screen_address(tgestate_t *state, uint16_t offset);
+attribute_t *screen_attribute_address(tgestate_t *state, const uint8_t *addr);
+uint8_t *get_next_char_row(tgestate_t *state, uint8_t *addr);
+uint8_t *get_prev_char_row(tgestate_t *state, uint8_t *addr);
+
 /* $8000 onwards */
 
 /* $9000 onwards */
 
 void main_loop(tgestate_t *state);
+void choose_whether_to_render(tgestate_t *state);
+void repaint_game_window(tgestate_t *state);
 
 void check_morale(tgestate_t *state);
 
@@ -313,34 +328,8 @@ const screenlocstring_t *screenlocstring_plot(tgestate_t              *state,
 
 void get_supertiles(tgestate_t *state);
 
-void plot_bottommost_tiles(tgestate_t *state);
-void plot_topmost_tiles(tgestate_t *state);
-void plot_horizontal_tiles_common(tgestate_t       *state,
-                                  tileindex_t      *vistiles,
-                                  supertileindex_t *maptiles,
-                                  uint8_t           pos,
-                                  uint8_t          *window);
-
 void plot_all_tiles(tgestate_t *state);
 
-void plot_rightmost_tiles(tgestate_t *state);
-void plot_leftmost_tiles(tgestate_t *state);
-void plot_vertical_tiles_common(tgestate_t       *state,
-                                tileindex_t      *vistiles,
-                                supertileindex_t *maptiles,
-                                uint8_t           x,
-                                uint8_t          *window);
-
-uint8_t *plot_tile_then_advance(tgestate_t             *state,
-                                tileindex_t             tile_index,
-                                const supertileindex_t *psupertileindex,
-                                uint8_t                *scr);
-
-uint8_t *plot_tile(tgestate_t             *state,
-                   tileindex_t             tile_index,
-                   const supertileindex_t *psupertileindex,
-                   uint8_t                *scr);
-
 void shunt_map_left(tgestate_t *state);
 void shunt_map_right(tgestate_t *state);
 void shunt_map_up_right(tgestate_t *state);
@@ -358,6 +347,8 @@ void move_map_down_left(tgestate_t *state, uint8_t *pmove_map_y);
 attribute_t choose_game_window_attributes(tgestate_t *state);
 
 void zoombox(tgestate_t *state);
+int zoombox_step(tgestate_t *state);
+void zoombox_open(tgestate_t *state);
 void zoombox_fill(tgestate_t *state);
 void zoombox_draw_border(tgestate_t *state);
 void zoombox_draw_tile(tgestate_t     *state,
@@ -425,16 +416,17 @@ void searchlight_mask_test(tgestate_t *state, vischar_t *vischar);
 
 void locate_vischar_or_itemstruct_then_plot(tgestate_t *state);
 
-int locate_vischar_or_itemstruct(tgestate_t    *state,
-                                 uint8_t       *pindex,
-                                 vischar_t    **pvischar,
-                                 itemstruct_t **pitemstruct);
+int locate_vischars_and_itemstructs(tgestate_t *state,
+                                    drawable_t *drawables);
+
+void sort_drawables_by_depth(drawable_t *drawables, int count);
 
 void render_mask_buffer(tgestate_t *state);
 
 uint16_t multiply(uint8_t left, uint8_t right);
 
-void mask_against_tile(tileindex_t index, tilerow_t *dst);
+void mask_against_tile(const tileindex_t *tiles,
+                       uint64_t         *dst);
 
 int vischar_visible(tgestate_t      *state,
                     const vischar_t *vischar,
@@ -549,11 +541,7 @@ extern const uint8_t *animations[24];
 
 void mark_nearby_items(tgestate_t *state);
 
-uint8_t get_greatest_itemstruct(tgestate_t    *state,
-                                item_t         item_and_flag,
-                                uint16_t       x,
-                                uint16_t       y,
-                                itemstruct_t **pitemstr);
+drawable_t *get_nearby_itemstructs(tgestate_t *state, drawable_t *drawables);
 
 uint8_t setup_item_plotting(tgestate_t   *state,
                             itemstruct_t *itemstr,
@@ -567,7 +555,9 @@ extern const spritedef_t item_definitions[item__LIMIT];
 
 /* $E000 onwards */
 
-extern const size_t masked_sprite_plotter_16_enables[2 * 3];
+uint8_t make_masked_sprite_plotter_enables(uint8_t instr,
+                                           uint8_t offset,
+                                           uint8_t iters);
 
 void masked_sprite_plotter_24_wide(tgestate_t *state, vischar_t *vischar);
 
@@ -597,6 +587,14 @@ INLINE void divide_by_8_with_rounding(uint8_t *A, uint8_t *C);
 INLINE void divide_by_8(uint8_t *A, uint8_t *C);
 
 void plot_game_window(tgestate_t *state);
+void mark_window_buf_dirty(tgestate_t    *state,
+                           const uint8_t *p,
+                           int            width,
+                           int            height);
+void invalidate_game_window(tgestate_t *state);
+
+extern const tgerenderer_t renderer_24x17;
+extern const tgerenderer_t renderer_generic;
 
 timedevent_handler_t event_roll_call;
 
@@ -608,4 +606,8 @@ int user_confirm(tgestate_t *state);
 
 void wipe_full_screen_and_attributes(tgestate_t *state);
 
+/* Create.c */
+
+void capture_template(tgestate_t *state);
+
 #endif /* THEGREATESCAPE_H */
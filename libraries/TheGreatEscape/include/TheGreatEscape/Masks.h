@@ -6,6 +6,7 @@
 #include "TheGreatEscape/Types.h"
 
 extern const uint8_t *mask_pointers[30];
+extern const uint16_t mask_lengths[30];
 extern const mask_t exterior_mask_data[58];
 
 #endif /* MASKS_H */
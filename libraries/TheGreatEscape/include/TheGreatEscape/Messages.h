@@ -33,6 +33,9 @@ typedef enum message
 }
 message_t;
 
+/* Conv: Added */
+void render_messages(void);
+
 /* $7D15 */
 void queue_message_for_display(tgestate_t *state,
                                message_t   message_index);
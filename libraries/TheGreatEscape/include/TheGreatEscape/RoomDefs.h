@@ -7,41 +7,49 @@
 
 typedef uint8_t roomdef_t;
 
+/* Lengths of the room definitions which the game alters. */
+#define roomdef_2_LENGTH       38
+#define roomdef_3_LENGTH       50
+#define roomdef_5_LENGTH       50
+#define roomdef_23_LENGTH      46
+#define roomdef_25_LENGTH      41
+#define roomdef_50_LENGTH      32
+
 extern const roomdef_t *rooms_and_tunnels[room__LIMIT];
 
-extern uint8_t roomdef_1_hut1_right[];
-extern uint8_t roomdef_2_hut2_left[];
-extern uint8_t roomdef_3_hut2_right[];
-extern uint8_t roomdef_4_hut3_left[];
-extern uint8_t roomdef_5_hut3_right[];
-extern uint8_t roomdef_7_corridor[];
-extern uint8_t roomdef_8_corridor[];
-extern uint8_t roomdef_9_crate[];
-extern uint8_t roomdef_10_lockpick[];
-extern uint8_t roomdef_11_papers[];
-extern uint8_t roomdef_12_corridor[];
-extern uint8_t roomdef_13_corridor[];
-extern uint8_t roomdef_14_torch[];
-extern uint8_t roomdef_15_uniform[];
-extern uint8_t roomdef_16_corridor[];
-extern uint8_t roomdef_18_radio[];
-extern uint8_t roomdef_19_food[];
-extern uint8_t roomdef_20_redcross[];
-extern uint8_t roomdef_22_red_key[];
-extern uint8_t roomdef_23_breakfast[];
-extern uint8_t roomdef_24_solitary[];
-extern uint8_t roomdef_25_breakfast[];
-extern uint8_t roomdef_28_hut1_left[];
-extern uint8_t roomdef_29_second_tunnel_start[];
-extern uint8_t roomdef_30[];
-extern uint8_t roomdef_31[];
-extern uint8_t roomdef_32[];
-extern uint8_t roomdef_34[];
-extern uint8_t roomdef_35[];
-extern uint8_t roomdef_36[];
-extern uint8_t roomdef_40[];
-extern uint8_t roomdef_44[];
-extern uint8_t roomdef_50_blocked_tunnel[];
+extern const uint8_t roomdef_1_hut1_right[];
+extern const uint8_t roomdef_2_hut2_left[roomdef_2_LENGTH];
+extern const uint8_t roomdef_3_hut2_right[roomdef_3_LENGTH];
+extern const uint8_t roomdef_4_hut3_left[];
+extern const uint8_t roomdef_5_hut3_right[roomdef_5_LENGTH];
+extern const uint8_t roomdef_7_corridor[];
+extern const uint8_t roomdef_8_corridor[];
+extern const uint8_t roomdef_9_crate[];
+extern const uint8_t roomdef_10_lockpick[];
+extern const uint8_t roomdef_11_papers[];
+extern const uint8_t roomdef_12_corridor[];
+extern const uint8_t roomdef_13_corridor[];
+extern const uint8_t roomdef_14_torch[];
+extern const uint8_t roomdef_15_uniform[];
+extern const uint8_t roomdef_16_corridor[];
+extern const uint8_t roomdef_18_radio[];
+extern const uint8_t roomdef_19_food[];
+extern const uint8_t roomdef_20_redcross[];
+extern const uint8_t roomdef_22_red_key[];
+extern const uint8_t roomdef_23_breakfast[roomdef_23_LENGTH];
+extern const uint8_t roomdef_24_solitary[];
+extern const uint8_t roomdef_25_breakfast[roomdef_25_LENGTH];
+extern const uint8_t roomdef_28_hut1_left[];
+extern const uint8_t roomdef_29_second_tunnel_start[];
+extern const uint8_t roomdef_30[];
+extern const uint8_t roomdef_31[];
+extern const uint8_t roomdef_32[];
+extern const uint8_t roomdef_34[];
+extern const uint8_t roomdef_35[];
+extern const uint8_t roomdef_36[];
+extern const uint8_t roomdef_40[];
+extern const uint8_t roomdef_44[];
+extern const uint8_t roomdef_50_blocked_tunnel[roomdef_50_LENGTH];
 
 #define roomdef_23_BENCH_A     (10 +  9 * 3)
 #define roomdef_23_BENCH_B     (10 + 10 * 3)
@@ -56,4 +64,20 @@ extern uint8_t roomdef_50_blocked_tunnel[];
 
 #define roomdef_50_BLOCKAGE    (14 +  3 * 3)
 
+/**
+ * Conv: Added. An instance's copies of the room definitions which the game
+ * alters: the beds, the benches and the blocked tunnel. The originals are
+ * patched in place, but those are shared by every instance.
+ */
+typedef struct roomdefs
+{
+  roomdef_t hut2_left[roomdef_2_LENGTH];
+  roomdef_t hut2_right[roomdef_3_LENGTH];
+  roomdef_t hut3_right[roomdef_5_LENGTH];
+  roomdef_t breakfast_23[roomdef_23_LENGTH];
+  roomdef_t breakfast_25[roomdef_25_LENGTH];
+  roomdef_t blocked_tunnel[roomdef_50_LENGTH];
+}
+roomdefs_t;
+
 #endif /* ROOMDEFS_H */
@@ -4,19 +4,49 @@
 #include <setjmp.h>
 #include <stdint.h>
 
+#include "TheGreatEscape/RoomDefs.h"
 #include "TheGreatEscape/Types.h"
 
 #include "TheGreatEscape/TheGreatEscape.h"
 
+/**
+ * Alignment of a structure member to a cache line.
+ */
+#if defined(__GNUC__)
+#define CACHE_ALIGNED __attribute__((aligned(TGE_ALIGNMENT)))
+#elif defined(_MSC_VER)
+#define CACHE_ALIGNED __declspec(align(TGE_ALIGNMENT))
+#else
+#define CACHE_ALIGNED
+#endif
+
+/**
+ * Budget for the hot part of tgestate_t, in bytes: everything before 'cold'.
+ * Every frame touches most of it, so it needs to stay resident in L1. It is
+ * 34 cache lines. A 64-bit glibc build uses all of them: about 1.8KiB on the
+ * character and item structs and the visible characters, and 200 bytes on
+ * jmpbuf_main, of which setjmp writes only the first 72 or so. Create.c
+ * asserts the budget at compile time.
+ */
+#define TGESTATE_HOT_BUDGET (34 * TGE_ALIGNMENT)
+
 /**
  * Holds the current state of the game.
+ *
+ * Conv: Grouped by use rather than by original memory location. The fields
+ * used on every frame come first and are packed together. The rest are in
+ * 'cold', which starts on its own cache line. Within each group the original
+ * variables remain in address order.
  */
 struct tgestate
 {
+  /* HOT: used on every frame. */
+
   /* ADDITIONAL VARIABLES (those not in the original game) */
 
-  int             width;      /* real screen width in UDGs e.g. 32 */
-  int             height;     /* real screen height in UDGs e.g. 24 */
+  const tgerenderer_t *renderer; /* rendering routines for the window size */
+
+  zxspectrum_t   *speccy;
 
   int             columns;    /* game window width in UDGs e.g. 23 */
   int             rows;       /* game window height in UDGs e.g. 16 */
@@ -24,10 +54,13 @@ struct tgestate
   int             st_columns; /* supertiles columns (normally 7) */
   int             st_rows;    /* supertiles rows (normally 5) */
 
-  zxspectrum_t   *speccy;
-
-  jmp_buf         jmpbuf_main;
+  int             render_interval;  /* render every Nth frame, 0 = on request */
+  int             render_countdown; /* frames until the next render */
+  int             render_requested; /* render the next frame regardless */
+  int             rendering;        /* this frame plots the game window */
+  int             window_stale;     /* window_buf missed frames: repaint it */
 
+  jmp_buf         jmpbuf_main;      /* set by tge_main on every frame */
 
   /* REGISTER VARIABLES */
   vischar_t      *IY;
@@ -44,13 +77,6 @@ struct tgestate
    */
   door_t          current_door;
 
-  /**
-   * $69AE: Movable items.
-   *
-   * Used by setup_movable_items and reset_visible_character. 
-   */
-  movableitem_t   movable_items[movable_item__LIMIT];
-
   /**
    * $7612: Character structures.
    *
@@ -66,15 +92,10 @@ struct tgestate
    * accept_bribe, action_red_cross_parcel, action_poison,
    * follow_suspicious_character, character_behaviour, bribes_solitary_food,
    * solitary, is_item_discoverable, is_item_discoverable_interior,
-   * mark_nearby_items and get_greatest_itemstruct.
+   * mark_nearby_items and get_nearby_itemstructs.
    */
   itemstruct_t    item_structs[item__LIMIT];
 
-  /**
-   * $783A: Map locations.
-   */
-  xy_t            locations[78];
-
   struct
   {
     /** $7CFC: Queue of message indexes.
@@ -93,23 +114,32 @@ struct tgestate
     
     /** $7D13: Pointer to the next message character to be displayed. */
     const char   *current_character;
+
+    /** Conv: Added. Pre-rendered bitmap of the message being displayed. */
+    const textstrip_t *current_strip;
   }
   messages;
 
-  /**
-   * $7F00: A table of 256 bit-reversed bytes.
-   *
-   * Read by flip_16_masked_pixels and flip_24_masked_pixels only.
-   */
-  uint8_t         reversed[256];
+  /* $7F00: A table of 256 bit-reversed bytes. Conv: Now constant. */
 
   /** $8000: Array of visible characters. */
   vischar_t       vischars[vischars_LENGTH];
 
-#define MASK_BUFFER_WIDTH 32 // BUT is the buffer 32 wide? The draw buffer is only 24 wide!
-  /** $8100: Mask buffer. */
-  // TODO: Dynamically allocate.
-  uint8_t         mask_buffer[5 * MASK_BUFFER_WIDTH];
+#define MASK_BUFFER_ROWBYTES 4 /* bytes per pixel row: four tiles across */
+#define MASK_BUFFER_WIDTH    (MASK_BUFFER_ROWBYTES * 8) /* bytes per row of tiles */
+#define MASK_BUFFER_HEIGHT   5 /* rows of tiles */
+#define MASK_BUFFER_LENGTH   (MASK_BUFFER_HEIGHT * MASK_BUFFER_WIDTH)
+  /** $8100: Mask buffer.
+   *
+   * Four tiles wide by five tiles high, stored a pixel row at a time. Each
+   * row of tiles is exactly four words so it is cleared and masked 64 bits
+   * at a time. */
+  union
+  {
+    uint64_t      words[MASK_BUFFER_LENGTH / 8];
+    uint8_t       bytes[MASK_BUFFER_LENGTH];
+  }
+  mask_buffer;
 
   /** $81A2: Pointer into window_buf[]. Used by masked sprite plotters. */
   uint8_t        *window_buf_pointer;
@@ -198,9 +228,6 @@ struct tgestate
   /** $A130: Bell ringing. */
   bellring_t      bell;
 
-  /** $A132: Score digits. */
-  char            score_digits[5];
-
   /** $A137: The hero is in breakfast (flag: 0 or 255). */
   uint8_t         hero_in_breakfast;
 
@@ -241,14 +268,6 @@ struct tgestate
    */
   uint8_t         displayed_morale;
 
-  /** $A141: Pointer to the screen address where the morale flag was last
-   * plotted. */
-  uint8_t        *moraleflag_screen_address;
-
-  /** $A143: Pointer to a door in gates_and_doors[] in which door_LOCKED is
-   * cleared when picked. */
-  door_t         *ptr_to_door_being_lockpicked;
-
   /** $A145: Game time when player control is restored.
    * e.g. when picking a lock or cutting wire. */
   gametime_t      player_locked_out_until;
@@ -256,9 +275,6 @@ struct tgestate
   /** $A146: Day or night time (flag: day is 0, night is 255). */
   uint8_t         day_or_night;
 
-  /** $A263: Current contents of red cross parcel. */
-  item_t          red_cross_parcel_current_contents;
-
   /** $A7C6: An index used only by move_map(). */
   uint8_t         move_map_y;
 
@@ -272,12 +288,13 @@ struct tgestate
     uint8_t       width;
     uint8_t       y;
     uint8_t       height;
+
+    /** Conv: Added. Non-zero while the zoombox is opening. tge_main
+     * advances it a step per frame. */
+    uint8_t       opening;
   }
   zoombox;
 
-  /** $AB6A: Stored copy of game screen attribute, used to draw zoombox. */
-  attribute_t     game_window_attribute;
-
   struct
   {
     /** $AD29: Searchlight movement data. */
@@ -292,46 +309,34 @@ struct tgestate
   }
   searchlight;
 
-  /** $AF8E: Bribed character. */
-  character_t     bribed_character;
-
   /** $C41A: Pseudo-random number generator index. */
   uint8_t         prng_index;
 
-  /** $C891: A countdown until any food item is discovered. */
-  uint8_t         food_discovered_counter;
-
-  /** $DD69: Item attributes. */
-  attribute_t     item_attributes[item__LIMIT];
-
   /** $E121 .. $E363: (Formerly) Self-modified locations. */
   uint8_t         self_E121; // masked_sprite_plotter_24_wide: height loop in right shift case = clipped_height & 0xFF
   uint8_t         self_E1E2; // masked_sprite_plotter_24_wide: height loop in left shift case = clipped_height & 0xFF
   uint8_t         self_E2C2; // masked_sprite_plotter_16_wide_left: height loop = clipped height & 0xFF
   uint8_t         self_E363; // masked_sprite_plotter_16_wide_right: height loop = clipped height & 0xFF
 
-  /* Note that these adjacent chunks actually overlap in the original game 
-   * but I've divided them here for clarity. */
-
-  /** $E188 .. $E290: (Formerly) Self-modified disabled instructions. */
-  uint8_t         enable_E188; // 24 case
-  uint8_t         enable_E259; // 24 case
-  uint8_t         enable_E199; // 24 case
-  uint8_t         enable_E26A; // 24 case
-  uint8_t         enable_E1AA; // 24 case
-  uint8_t         enable_E27B; // 24 case
-  uint8_t         enable_E1BF; // 24 case
-  uint8_t         enable_E290; // 24 case
-
-  uint8_t         enable_E319; // 16 case masked_sprite_plotter_16_wide_left
-  uint8_t         enable_E32A; // 16 case masked_sprite_plotter_16_wide_left
-  uint8_t         enable_E340; // 16 case masked_sprite_plotter_16_wide_left
-  uint8_t         enable_E3C5; // 16 case masked_sprite_plotter_16_wide_right
-  uint8_t         enable_E3D6; // 16 case masked_sprite_plotter_16_wide_right
-  uint8_t         enable_E3EC; // 16 case masked_sprite_plotter_16_wide_right
-
-  /** $EDD3: Start addresses for game screen (usually 128). */
-  uint16_t       *game_window_start_offsets;
+  /** $E188 .. $E3EC: (Formerly) Self-modified disabled instructions.
+   *
+   * Conv: The original game clips sprites horizontally by switching
+   * LD (HL),A instructions in the plotters to NOPs. Instead the setup
+   * routines select row plotters specialised for the enabled columns. */
+  maskedrowplotter_t masked_sprite_plotter_24_right; // was enable_E188, E199, E1AA, E1BF
+  maskedrowplotter_t masked_sprite_plotter_24_left;  // was enable_E259, E26A, E27B, E290
+  maskedrowplotter_t masked_sprite_plotter_16_left;  // was enable_E319, E32A, E340
+  maskedrowplotter_t masked_sprite_plotter_16_right; // was enable_E3C5, E3D6, E3EC
+
+  /** $EDD3: Start addresses for game screen (usually 128).
+   *
+   * Conv: Points to a constant table chosen to suit the screen layout. */
+  const uint16_t *game_window_start_offsets;
+
+  /** Conv: Added. Distance from one scanline to the next within a row of
+   * character cells: 256 in the Spectrum's screen layout, 32 in the linear
+   * layout. */
+  uint16_t        cell_scanline_stride;
 
   /** $F05D: Gates and doors. */
   door_t          gates_and_doors[11];
@@ -339,26 +344,100 @@ struct tgestate
   /** $F06B: Key definitions. */
   keydefs_t       keydefs;
 
-  /* $F075: static_tiles_plot_direction - removed. */
+  /* replacing direct access to $F0F8 .. $F28F. 24 x 17. */
+  tileindex_t    *tile_buf;
 
   /** $F445: Chosen input device. */
   inputdevice_t   chosen_input_device;
 
-  /** $F541: Music channel indices. */
-  uint16_t        music_channel0_index;
-  uint16_t        music_channel1_index;
-
-
-  /* replacing direct access to $F0F8 .. $F28F. 24 x 17. */
-  tileindex_t    *tile_buf;
-
   /* replacing direct access to $F290 .. $FE8F. 24 x 17 x 8. */
   uint8_t        *window_buf; // tilerow_t?
 
+#define WINDOW_BUF_MAX_ROWS 17
+  /** Conv: Added. Tiles of window_buf changed since plot_game_window last
+   * copied them to the screen. Bit N of element M is set when the tile in
+   * column N of row M is dirty. */
+  uint32_t        window_buf_dirty[WINDOW_BUF_MAX_ROWS];
+
+  /** Conv: Added. game_window_offset as of the last plot_game_window. */
+  xy_t            window_buf_plotted_offset;
+
   // $FE90 - 200 bytes unaccounted for
 
   /* replacing direct access to $FF58 .. $FF7A. 7 x 5. */
   supertileindex_t      *map_buf;
+
+
+  /* COLD: used on setup, room changes, or rarely. */
+
+  CACHE_ALIGNED struct
+  {
+    /* ADDITIONAL VARIABLES (those not in the original game) */
+
+    int           width;      /* real screen width in UDGs e.g. 32 */
+    int           height;     /* real screen height in UDGs e.g. 24 */
+
+    int           skip_transitions; /* open the zoombox at once */
+    int           skip_menu;        /* start in play without the menu */
+
+    void         *heap;       /* block to release on destroy, or NULL if the caller owns it */
+
+
+    /* ORIGINAL VARIABLES (ordered by original game memory location) */
+
+    /**
+     * $69AE: Movable items.
+     *
+     * Used by setup_movable_items and reset_visible_character. 
+     */
+    movableitem_t   movable_items[movable_item__LIMIT];
+
+    /**
+     * $6BAD: Room definitions which the game alters.
+     *
+     * Conv: The original patches the shared definitions in place.
+     */
+    roomdefs_t      roomdefs;
+
+    /**
+     * $783A: Map locations.
+     */
+    xy_t            locations[78];
+
+    /** $A132: Score digits. */
+    char            score_digits[5];
+
+    /** $A141: Pointer to the screen address where the morale flag was last
+     * plotted. */
+    uint8_t        *moraleflag_screen_address;
+
+    /** $A143: Pointer to a door in gates_and_doors[] in which door_LOCKED is
+     * cleared when picked. */
+    door_t         *ptr_to_door_being_lockpicked;
+
+    /** $A263: Current contents of red cross parcel. */
+    item_t          red_cross_parcel_current_contents;
+
+    /** $AB6A: Stored copy of game screen attribute, used to draw zoombox. */
+    attribute_t     game_window_attribute;
+
+    /** $AF8E: Bribed character. */
+    character_t     bribed_character;
+
+    /** $C891: A countdown until any food item is discovered. */
+    uint8_t         food_discovered_counter;
+
+    /** $DD69: Item attributes. */
+    attribute_t     item_attributes[item__LIMIT];
+
+    /* $F075: static_tiles_plot_direction - removed. */
+
+    /** $F541: Music channel indices. */
+    uint16_t        music_channel0_index;
+    uint16_t        music_channel1_index;
+
+  }
+  cold;
 };
 
 #endif /* STATE_H */
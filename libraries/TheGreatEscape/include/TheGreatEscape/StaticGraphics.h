@@ -32,6 +32,7 @@ extern const statictileline_t static_graphic_defs[18];
 /* ----------------------------------------------------------------------- */
 
 void plot_statics_and_menu_text(tgestate_t *state);
+void plot_statics(tgestate_t *state);
 
 /* ----------------------------------------------------------------------- */
 
@@ -1,7 +1,16 @@
 #ifndef TEXT_H
 #define TEXT_H
 
-uint8_t *plot_glyph(const char *pcharacter, uint8_t *output);
-uint8_t *plot_single_glyph(int character, uint8_t *output);
+#include "TheGreatEscape/Types.h"
+
+uint8_t *plot_glyph(tgestate_t *state, const char *pcharacter, uint8_t *output);
+uint8_t *plot_single_glyph(tgestate_t *state, int character, uint8_t *output);
+
+void render_text_strip(const char *string, int length, textstrip_t *strip);
+uint8_t *plot_text_strip(tgestate_t        *state,
+                         const textstrip_t *strip,
+                         int                first,
+                         int                count,
+                         uint8_t           *output);
 
 #endif /* TEXT_H */
@@ -22,10 +22,21 @@ typedef struct
 }
 tile_t;
 
+/**
+ * Lengths of the exterior tile sets, which are stored one after another.
+ */
+enum
+{
+  exterior_tiles_1_LENGTH = 145,
+  exterior_tiles_2_LENGTH = 220,
+  exterior_tiles_3_LENGTH = 206,
+  exterior_tiles__LIMIT   = exterior_tiles_1_LENGTH +
+                            exterior_tiles_2_LENGTH +
+                            exterior_tiles_3_LENGTH
+};
+
 extern const tile_t mask_tiles[111];
-extern const tile_t exterior_tiles_1[145];
-extern const tile_t exterior_tiles_2[220];
-extern const tile_t exterior_tiles_3[206];
+extern const tile_t exterior_tiles[exterior_tiles__LIMIT];
 extern const tile_t interior_tiles[194];
 
 #endif /* TILES_H */
@@ -27,8 +27,15 @@ enum
   /** Limit of simultaneous visible characters. */
   vischars_LENGTH = 8,
 
+  /** Limit of entries in a frame's draw list (every vischar plus every
+   * item). */
+  drawables_LENGTH = vischars_LENGTH + item__LIMIT,
+
   /** Available beds. */
-  beds_LENGTH = 6
+  beds_LENGTH = 6,
+
+  /** Longest string which can be pre-rendered, in characters. */
+  textstrip_MAX_LENGTH = 24
 };
 
 /* ----------------------------------------------------------------------- */
@@ -204,7 +211,7 @@ enum vischar_flags
   vischar_BYTE7_MASK_HI                = 0xF0,
   vischar_BYTE7_IMPEDED                = 1 << 5, // set when hero hits an obstacle X, but cleared on Y obstacle?
   vischar_BYTE7_TOUCHING               = 1 << 6, // set when touch() sees a character touching. stops the map moving
-  vischar_BYTE7_LOCATABLE              = 1 << 7, // set by touch(). stops locate_vischar_or_itemstruct considering a vischar
+  vischar_BYTE7_LOCATABLE              = 1 << 7, // set by touch(). stops locate_vischars_and_itemstructs considering a vischar
 
   vischar_BYTE12_BIT7                  = 1 << 7, // up/down flag
 
@@ -225,7 +232,7 @@ enum itemstruct_flags
 
   itemstruct_ROOM_NONE                 = 0x3F,
   itemstruct_ROOM_MASK                 = 0x3F,
-  itemstruct_ROOM_FLAG_NEARBY_6        = 1 << 6, /**< Set when the item is nearby. Cleared by mark_nearby_items and locate_vischar_or_itemstruct. */
+  itemstruct_ROOM_FLAG_NEARBY_6        = 1 << 6, /**< Set when the item is nearby. Cleared by mark_nearby_items and get_nearby_itemstructs. */
   itemstruct_ROOM_FLAG_NEARBY_7        = 1 << 7  /**< Set when the item is nearby. Cleared by mark_nearby_items. Enables find_nearby_item for the item. follow_suspicious_character uses it on item_FOOD to trigger guard dog stuff. */
 };
 
@@ -518,6 +525,17 @@ typedef struct screenlocstring
 }
 screenlocstring_t;
 
+/**
+ * A string pre-rendered from the font. Row N holds scanline N of each
+ * character in turn, so can be copied to the screen in one go.
+ */
+typedef struct textstrip
+{
+  uint8_t length; /**< in characters */
+  uint8_t rows[8][textstrip_MAX_LENGTH];
+}
+textstrip_t;
+
 /**
  * Defines a character.
  */
@@ -620,6 +638,42 @@ bounds_t;
  */
 typedef input_t (*inputroutine_t)(tgestate_t *state);
 
+/**
+ * Signature of a masked sprite row plotter. shift is the original jump
+ * table offset into the mask and bitmap rotates.
+ */
+typedef void (*maskedrowplotter_t)(tgestate_t *state, uint8_t shift);
+
+/**
+ * Conv: Added. Rendering routines specialised for one size of game window.
+ *
+ * The row plotter tables are indexed by the masks built by
+ * make_masked_sprite_plotter_enables.
+ */
+typedef struct tgerenderer
+{
+  void (*get_supertiles)(tgestate_t *state);
+  void (*plot_interior_tiles)(tgestate_t *state);
+  void (*plot_all_tiles)(tgestate_t *state);
+  void (*shunt_map_left)(tgestate_t *state);
+  void (*shunt_map_right)(tgestate_t *state);
+  void (*shunt_map_up_right)(tgestate_t *state);
+  void (*shunt_map_up)(tgestate_t *state);
+  void (*shunt_map_down)(tgestate_t *state);
+  void (*shunt_map_down_left)(tgestate_t *state);
+  void (*mark_window_buf_dirty)(tgestate_t    *state,
+                                const uint8_t *p,
+                                int            width,
+                                int            height);
+  void (*plot_game_window)(tgestate_t *state);
+
+  const maskedrowplotter_t *masked_sprite_plotters_16_left;  /* [8] */
+  const maskedrowplotter_t *masked_sprite_plotters_16_right; /* [8] */
+  const maskedrowplotter_t *masked_sprite_plotters_24_right; /* [16] */
+  const maskedrowplotter_t *masked_sprite_plotters_24_left;  /* [16] */
+}
+tgerenderer_t;
+
 /**
  * Holds default item locations.
  */
@@ -674,6 +728,16 @@ typedef struct anim
 }
 anim_t;
 
+/**
+ * An entry in the frame's depth-sorted draw list.
+ */
+typedef struct drawable
+{
+  uint16_t depth; /**< isometric depth: x + y in map units */
+  uint8_t  index; /**< vischar index, or item index | item_FOUND */
+}
+drawable_t;
+
 /* ----------------------------------------------------------------------- */
 
 #endif /* TYPES_H */
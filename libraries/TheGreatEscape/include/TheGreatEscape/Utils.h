@@ -7,6 +7,12 @@
 
 #define NELEMS(a) ((int) (sizeof(a) / sizeof(a[0])))
 
+/**
+ * Fails to compile when condition c is false. name must be unique within
+ * the scope.
+ */
+#define STATIC_ASSERT(c,name) typedef char static_assert_##name[(c) ? 1 : -1]
+
 #define MIN(a,b) ((a) < (b) ? (a) : (b))
 #define MAX(a,b) ((a) > (b) ? (a) : (b))
 
@@ -91,4 +97,32 @@ do {                \
 
 /* ----------------------------------------------------------------------- */
 
+/* Atomics, for state shared between instances. */
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Atomically store n at p if p holds o. Returns non-zero if it did. A full
+ * barrier.
+ */
+#ifdef _MSC_VER
+#define COMPARE_AND_SWAP(p, o, n) (_InterlockedCompareExchange((p), (n), (o)) == (o))
+#else
+#define COMPARE_AND_SWAP(p, o, n) __sync_bool_compare_and_swap((p), (o), (n))
+#endif
+
+/**
+ * Load the long at p with acquire ordering: nothing read after it can be
+ * read before it. (MSVC gives volatile loads acquire semantics.)
+ */
+#ifdef _MSC_VER
+#define LOAD_ACQUIRE(p) (*(volatile long *) (p))
+#else
+#define LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#endif
+
+/* ----------------------------------------------------------------------- */
+
 #endif /* UTILS_H */
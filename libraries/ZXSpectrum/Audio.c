@@ -0,0 +1,200 @@
+/* ZXAudio.c
+ *
+ * ZX Spectrum beeper synthesis.
+ *
+ * Copyright (c) David Thomas, 2013-2016. <dave@davespace.co.uk>
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define BARRIER() MemoryBarrier()
+#else
+#define BARRIER() __sync_synchronize()
+#endif
+
+#include "ZXSpectrum/Audio.h"
+
+/* Ring buffer length in samples. Must be a power of two. */
+#define RING_LENGTH 16384
+
+/* Peak amplitude of a speaker-high sample. */
+#define AMPLITUDE   8192
+
+/* DC blocker pole in Q15 (~0.995). */
+#define DC_POLE     32604
+
+// Time is tracked in "units" where one T-state is ZXAUDIO_SAMPLE_RATE units
+// and one output sample is ZXAUDIO_CLOCK_RATE units, so no rounding error
+// accumulates between the two clocks.
+
+struct zxaudio
+{
+  /* Producer side */
+  uint64_t          now;    /* Virtual clock time synthesised up to */
+  int               level;  /* Current speaker level */
+  uint32_t          phase;  /* Units into the current sample */
+  uint64_t          acc;    /* Speaker-high units in the current sample */
+  int32_t           x1, y1; /* DC blocker history */
+
+  /* Ring: head is only written by the producer, tail by the consumer. */
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  int16_t           ring[RING_LENGTH];
+};
+
+zxaudio_t *zxaudio_create(void)
+{
+  void *block;
+
+  block = malloc(sizeof(zxaudio_t));
+  if (block == NULL)
+    return NULL;
+
+  return zxaudio_init(block);
+}
+
+void zxaudio_destroy(zxaudio_t *doomed)
+{
+  free(doomed);
+}
+
+size_t zxaudio_footprint(void)
+{
+  return sizeof(zxaudio_t);
+}
+
+zxaudio_t *zxaudio_init(void *block)
+{
+  zxaudio_t *audio = block;
+
+  assert(audio != NULL);
+
+  memset(audio, 0, sizeof(*audio));
+
+  return audio;
+}
+
+static void emit(zxaudio_t *audio)
+{
+  int32_t  x, y;
+  uint32_t head;
+
+  x = (int32_t) (audio->acc * AMPLITUDE / ZXAUDIO_CLOCK_RATE);
+  y = x - audio->x1 + ((audio->y1 * DC_POLE) >> 15);
+  audio->x1 = x;
+  audio->y1 = y;
+
+  head = audio->head;
+  if (head - audio->tail >= RING_LENGTH)
+    return; /* Full: drop the sample rather than wait. */
+
+  audio->ring[head & (RING_LENGTH - 1)] = (int16_t) y;
+  BARRIER(); /* Publish the sample before the index. */
+  audio->head = head + 1;
+}
+
+void zxaudio_advance(zxaudio_t *audio, uint64_t tstates)
+{
+  uint64_t units;
+  uint32_t need;
+
+  assert(audio != NULL);
+
+  if (tstates <= audio->now)
+    return;
+
+  units = (tstates - audio->now) * ZXAUDIO_SAMPLE_RATE;
+  audio->now = tstates;
+
+  /* Box filter: each sample is the mean speaker level over its period. */
+  for (;;)
+  {
+    need = ZXAUDIO_CLOCK_RATE - audio->phase;
+    if (units < need)
+    {
+      if (audio->level)
+        audio->acc += units;
+      audio->phase += (uint32_t) units;
+      break;
+    }
+
+    if (audio->level)
+      audio->acc += need;
+    emit(audio);
+    units -= need;
+    audio->phase = 0;
+    audio->acc   = 0;
+  }
+}
+
+void zxaudio_speaker(zxaudio_t *audio, uint64_t tstates, int level)
+{
+  assert(audio != NULL);
+
+  zxaudio_advance(audio, tstates);
+  audio->level = level != 0;
+}
+
+int zxaudio_read(zxaudio_t *audio, int16_t *samples, int nsamples)
+{
+  uint32_t tail;
+  uint32_t avail;
+  int      i;
+
+  assert(audio != NULL);
+  assert(samples != NULL);
+
+  tail  = audio->tail;
+  avail = audio->head - tail;
+  BARRIER(); /* Read the index before the samples it covers. */
+
+  if ((uint32_t) nsamples > avail)
+    nsamples = (int) avail;
+
+  for (i = 0; i < nsamples; i++)
+    samples[i] = audio->ring[(tail + i) & (RING_LENGTH - 1)];
+
+  BARRIER(); /* Finish reading before releasing the slots. */
+  audio->tail = tail + nsamples;
+
+  return nsamples;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t) (v >> 0);
+  p[1] = (uint8_t) (v >> 8);
+  p[2] = (uint8_t) (v >> 16);
+  p[3] = (uint8_t) (v >> 24);
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+  p[0] = (uint8_t) (v >> 0);
+  p[1] = (uint8_t) (v >> 8);
+}
+
+void zxaudio_wav_header(uint8_t header[ZXAUDIO_WAV_HEADER_LENGTH],
+                        uint32_t nsamples)
+{
+  uint32_t datalen = nsamples * 2;
+
+  put32(&header[0],  0x46464952); /* "RIFF" */
+  put32(&header[4],  36 + datalen);
+  put32(&header[8],  0x45564157); /* "WAVE" */
+  put32(&header[12], 0x20746D66); /* "fmt " */
+  put32(&header[16], 16);         /* fmt chunk length */
+  put16(&header[20], 1);          /* PCM */
+  put16(&header[22], 1);          /* mono */
+  put32(&header[24], ZXAUDIO_SAMPLE_RATE);
+  put32(&header[28], ZXAUDIO_SAMPLE_RATE * 2); /* byte rate */
+  put16(&header[32], 2);          /* block align */
+  put16(&header[34], 16);         /* bits per sample */
+  put32(&header[36], 0x61746164); /* "data" */
+  put32(&header[40], datalen);
+}
@@ -0,0 +1,228 @@
+/* ZXEvents.c
+ *
+ * ZX Spectrum input event queue.
+ *
+ * Copyright (c) David Thomas, 2016. <dave@davespace.co.uk>
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L /* for clock_gettime and pthreads */
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define BARRIER() MemoryBarrier()
+#else
+#include <pthread.h>
+#include <time.h>
+#define BARRIER() __sync_synchronize()
+#endif
+
+#include "ZXSpectrum/Events.h"
+
+/* Queue length in events. Must be a power of two. */
+#define QUEUE_LENGTH 256
+
+struct zxevents
+{
+  /* head is only written by the producer, tail by the consumer. */
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  zxevent_t         queue[QUEUE_LENGTH];
+
+  /* Set by zxevents_wait while it may block. Pushes only take the lock and
+   * signal when it's set, so the queue stays lock-free otherwise. */
+  volatile int      waiting;
+
+  /* Signalled after a push seen by a waiter, for zxevents_wait. */
+#ifdef _WIN32
+  SRWLOCK            lock;
+  CONDITION_VARIABLE pushed;
+#else
+  pthread_mutex_t    lock;
+  pthread_cond_t     pushed;
+#endif
+};
+
+zxevents_t *zxevents_create(void)
+{
+  void       *block;
+  zxevents_t *events;
+
+  block = malloc(sizeof(*events));
+  if (block == NULL)
+    return NULL;
+
+  events = zxevents_init(block);
+  if (events == NULL)
+    free(block);
+
+  return events;
+}
+
+void zxevents_destroy(zxevents_t *doomed)
+{
+  if (doomed == NULL)
+    return;
+
+  zxevents_finalise(doomed);
+  free(doomed);
+}
+
+size_t zxevents_footprint(void)
+{
+  return sizeof(zxevents_t);
+}
+
+zxevents_t *zxevents_init(void *block)
+{
+  zxevents_t *events = block;
+
+  assert(events != NULL);
+
+  memset(events, 0, sizeof(*events));
+
+#ifdef _WIN32
+  InitializeSRWLock(&events->lock);
+  InitializeConditionVariable(&events->pushed);
+#else
+  if (pthread_mutex_init(&events->lock, NULL) != 0)
+    return NULL;
+  if (pthread_cond_init(&events->pushed, NULL) != 0)
+  {
+    pthread_mutex_destroy(&events->lock);
+    return NULL;
+  }
+#endif
+
+  return events;
+}
+
+void zxevents_finalise(zxevents_t *events)
+{
+  assert(events != NULL);
+
+#ifndef _WIN32
+  pthread_cond_destroy(&events->pushed);
+  pthread_mutex_destroy(&events->lock);
+#else
+  (void) events;
+#endif
+}
+
+int zxevents_push(zxevents_t *events, const zxevent_t *event)
+{
+  uint32_t head;
+
+  assert(events != NULL);
+  assert(event != NULL);
+
+  head = events->head;
+  if (head - events->tail >= QUEUE_LENGTH)
+    return 0; /* Full */
+
+  events->queue[head & (QUEUE_LENGTH - 1)] = *event;
+  BARRIER(); /* Publish the event before the index. */
+  events->head = head + 1;
+
+  /* Publish the index before checking for a waiter. The waiter sets its
+   * flag before re-checking the queue, so either it sees this event or we
+   * see the flag. Taking the lock then orders the signal after the waiter
+   * has started to wait, so the wakeup can't be lost. */
+  BARRIER();
+  if (events->waiting)
+  {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&events->lock);
+    WakeConditionVariable(&events->pushed);
+    ReleaseSRWLockExclusive(&events->lock);
+#else
+    pthread_mutex_lock(&events->lock);
+    pthread_cond_signal(&events->pushed);
+    pthread_mutex_unlock(&events->lock);
+#endif
+  }
+
+  return 1;
+}
+
+const zxevent_t *zxevents_peek(zxevents_t *events)
+{
+  uint32_t tail;
+
+  assert(events != NULL);
+
+  tail = events->tail;
+  if (events->head == tail)
+    return NULL; /* Empty */
+
+  BARRIER(); /* Read the index before the event it covers. */
+
+  return &events->queue[tail & (QUEUE_LENGTH - 1)];
+}
+
+void zxevents_pop(zxevents_t *events)
+{
+  assert(events != NULL);
+  assert(events->head != events->tail);
+
+  BARRIER(); /* Finish reading before releasing the slot. */
+  events->tail = events->tail + 1;
+}
+
+int zxevents_wait(zxevents_t *events, int timeout)
+{
+  int pending;
+#ifndef _WIN32
+  struct timespec deadline;
+#endif
+
+  assert(events != NULL);
+
+  if (events->head != events->tail)
+    return 1;
+  if (timeout <= 0)
+    return 0;
+
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&events->lock);
+  events->waiting = 1;
+  BARRIER(); /* Set the flag before re-checking the queue. */
+  if (events->head == events->tail)
+    (void) SleepConditionVariableSRW(&events->pushed,
+                                     &events->lock,
+                                     (DWORD) (timeout + 999) / 1000,
+                                     0);
+  events->waiting = 0;
+  pending = events->head != events->tail;
+  ReleaseSRWLockExclusive(&events->lock);
+#else
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec  += timeout / 1000000;
+  deadline.tv_nsec += (long) (timeout % 1000000) * 1000;
+  if (deadline.tv_nsec >= 1000000000)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+
+  pthread_mutex_lock(&events->lock);
+  events->waiting = 1;
+  BARRIER(); /* Set the flag before re-checking the queue. */
+  while (events->head == events->tail)
+    if (pthread_cond_timedwait(&events->pushed,
+                               &events->lock,
+                               &deadline) != 0)
+      break; /* Timed out */
+  events->waiting = 0;
+  pending = events->head != events->tail;
+  pthread_mutex_unlock(&events->lock);
+#endif
+
+  return pending;
+}
@@ -48,10 +48,7 @@ int zxkeyset_for_port(uint16_t port, zxkeyset_t keystate)
   return (~keystate >> (nzeroes * 5)) & 0x1F;
 }
 
-/**
- * Convert the given character to a zxkey_t.
- */
-static zxkey_t char_to_key(int c)
+zxkey_t zxkey_for_char(int c)
 {
   switch (toupper(c))
   {
@@ -151,7 +148,7 @@ static zxkey_t char_to_key(int c)
 
 zxkeyset_t zxkeyset_setchar(zxkeyset_t keystate, int c)
 {
-  zxkey_t sk = char_to_key(c);
+  zxkey_t sk = zxkey_for_char(c);
   if (sk != zxkey_UNKNOWN)
     keystate |= 1ULL << sk;
   return keystate;
@@ -159,7 +156,7 @@ zxkeyset_t zxkeyset_setchar(zxkeyset_t keystate, int c)
 
 zxkeyset_t zxkeyset_clearchar(zxkeyset_t keystate, int c)
 {
-  zxkey_t sk = char_to_key(c);
+  zxkey_t sk = zxkey_for_char(c);
   if (sk != zxkey_UNKNOWN)
     keystate &= ~(1ULL << sk);
   return keystate;
@@ -0,0 +1,235 @@
+/* ZXPacer.c
+ *
+ * ZX Spectrum frame pacing.
+ *
+ * Copyright (c) David Thomas, 2016. <dave@davespace.co.uk>
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L /* for clock_gettime */
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "ZXSpectrum/Pacer.h"
+
+/* Histogram bucket width in microseconds. */
+#define BUCKET_WIDTH    100
+
+/* Histogram buckets. The last bucket collects everything longer. */
+#define BUCKETS         2500
+
+/* Consecutive frames which may skip rendering before one is forced. */
+#define MAX_SKIPS       4
+
+/* Frame periods behind schedule at which the missed frames are dropped. */
+#define MAX_BEHIND      5
+
+struct zxpacer
+{
+  int64_t      period;     /* Target frame period, us */
+  int64_t      deadline;   /* When the current frame should end, us */
+  int64_t      started;    /* When the current frame started, us */
+  int          synced;     /* Whether deadline is valid */
+  int          measuring;  /* Whether started is valid */
+  int          skips;      /* Consecutive skipped frames */
+
+  unsigned int frames;
+  unsigned int skipped;
+  uint32_t     frame_time[BUCKETS];
+  uint32_t     jitter[BUCKETS];
+};
+
+/* Returns a monotonic time in microseconds. */
+static int64_t now_us(void)
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency, counter;
+
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000000 / frequency.QuadPart;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+zxpacer_t *zxpacer_create(int rate)
+{
+  void *block;
+
+  assert(rate > 0);
+
+  block = malloc(sizeof(zxpacer_t));
+  if (block == NULL)
+    return NULL;
+
+  return zxpacer_init(block, rate);
+}
+
+void zxpacer_destroy(zxpacer_t *doomed)
+{
+  free(doomed);
+}
+
+size_t zxpacer_footprint(void)
+{
+  return sizeof(zxpacer_t);
+}
+
+zxpacer_t *zxpacer_init(void *block, int rate)
+{
+  zxpacer_t *pacer = block;
+
+  assert(pacer != NULL);
+  assert(rate > 0);
+
+  memset(pacer, 0, sizeof(*pacer));
+  pacer->period = 1000000 / rate;
+
+  return pacer;
+}
+
+int zxpacer_period(const zxpacer_t *pacer)
+{
+  assert(pacer != NULL);
+
+  return (int) pacer->period;
+}
+
+int zxpacer_end_frame(zxpacer_t *pacer, int *wait)
+{
+  int64_t now;
+
+  assert(pacer != NULL);
+  assert(wait != NULL);
+
+  now   = now_us();
+  *wait = 0;
+
+  if (!pacer->synced)
+  {
+    /* This frame ends now. Schedule the following ones from here. */
+    pacer->deadline = now;
+    pacer->synced   = 1;
+    pacer->skips    = 0;
+    return 0;
+  }
+
+  pacer->deadline += pacer->period;
+  if (now <= pacer->deadline)
+  {
+    *wait = (int) (pacer->deadline - now);
+    pacer->skips = 0;
+    return 0;
+  }
+
+  /* Behind. If hopelessly so, drop the missed frames rather than race. */
+  if (now - pacer->deadline > pacer->period * MAX_BEHIND)
+    pacer->deadline = now;
+
+  if (pacer->skips >= MAX_SKIPS)
+  {
+    pacer->skips = 0;
+    return 0; /* Render this one regardless. */
+  }
+
+  pacer->skips++;
+  pacer->skipped++;
+  return 1;
+}
+
+static void record(uint32_t *histogram, int64_t us)
+{
+  int64_t bucket;
+
+  bucket = us / BUCKET_WIDTH;
+  if (bucket >= BUCKETS)
+    bucket = BUCKETS - 1;
+  histogram[bucket]++;
+}
+
+void zxpacer_start_frame(zxpacer_t *pacer)
+{
+  int64_t now;
+  int64_t frame_time;
+  int64_t jitter;
+
+  assert(pacer != NULL);
+
+  now = now_us();
+
+  if (pacer->measuring)
+  {
+    frame_time = now - pacer->started;
+    jitter     = frame_time - pacer->period;
+    if (jitter < 0)
+      jitter = -jitter;
+
+    record(pacer->frame_time, frame_time);
+    record(pacer->jitter, jitter);
+    pacer->frames++;
+  }
+
+  pacer->started   = now;
+  pacer->measuring = 1;
+}
+
+void zxpacer_resync(zxpacer_t *pacer)
+{
+  assert(pacer != NULL);
+
+  pacer->synced    = 0;
+  pacer->measuring = 0;
+}
+
+/* Fills in the 50th, 95th and 99th percentiles of the given histogram. */
+static void percentiles(const uint32_t *histogram,
+                        unsigned int    count,
+                        int            *out)
+{
+  static const int wanted[3] = { 50, 95, 99 };
+
+  uint64_t total;
+  int      bucket;
+  int      i;
+
+  if (count == 0)
+  {
+    out[0] = out[1] = out[2] = 0;
+    return;
+  }
+
+  total  = 0;
+  bucket = 0;
+  for (i = 0; i < 3; i++)
+  {
+    while (bucket < BUCKETS &&
+           (total + histogram[bucket]) * 100 < (uint64_t) count * wanted[i])
+      total += histogram[bucket++];
+    out[i] = (bucket < BUCKETS ? bucket + 1 : BUCKETS) * BUCKET_WIDTH;
+  }
+}
+
+void zxpacer_get_stats(const zxpacer_t *pacer, zxpacerstats_t *stats)
+{
+  assert(pacer != NULL);
+  assert(stats != NULL);
+
+  stats->frames  = pacer->frames;
+  stats->skipped = pacer->skipped;
+  percentiles(pacer->frame_time, pacer->frames, &stats->frame_time[0]);
+  percentiles(pacer->jitter,     pacer->frames, &stats->jitter[0]);
+}
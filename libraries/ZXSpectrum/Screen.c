@@ -5,47 +5,22 @@
  * Copyright (c) David Thomas, 2013-2015. <dave@davespace.co.uk>
  */
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "ZXSpectrum/Screen.h"
 
+/* Changed cells at which the whole screen is converted instead, as a
+ * straight run of rows is quicker than that many scattered cells. */
+#define WHOLE_SCREEN_CELLS (24 * 32 / 2)
+
 // Spectrum screen memory has the arrangement:
 // 0b010BBLLLRRRCCCCC (B = band, L = line, R = row, C = column)
 //
 // Attribute bytes have the format:
 // 0bLRBBBFFF (L = flash, R = bright, B = background, F = foreground)
 
-/* Given a screen memory address with fixed and column bits discarded,
- * returns the linear offset. */
-static int rows[192];
-
-void zxscreen_initialise(void)
-{
-  static int initialised = 0;
-
-  int i;
-  // int band, line, row;
-
-  if (initialised)
-    return;
-
-  for (i = 0; i < 192; i++)
-  {
-    // band = (i >> 6) & 3;
-    // line = (i >> 3) & 7;
-    // row  = (i >> 0) & 7;
-    //
-    // rows[i] = (band << 6) | (row << 3) | (line >> 0);
-    // rows[i] = (i & ~63) | ((i & 56) >> 3) | ((i & 7) << 3); // 8 ops
-
-    /* Transpose fields using XOR. */
-    unsigned int x = (i ^ (i >> 3)) & 7; // XOR temporary
-    rows[i] = i ^ (x | (x << 3));
-  }
-
-  initialised = 1;
-}
-
 #ifdef _WIN32
 #define BK_ 0x00000000
 #define RD_ 0x00010000
@@ -200,3 +175,139 @@ void zxscreen_convert(const void *vscr, unsigned int *poutput)
       pattrs -= 8;
   }
 }
+
+void zxscreen_convert_linear(const void *vscr, unsigned int *poutput)
+{
+  const unsigned int *pattrs;
+  int                 x,y;
+  const unsigned int *pinput;
+  unsigned int        input;
+  unsigned int        attrs;
+  const unsigned int *pal;
+
+  pinput = vscr;
+  pattrs = (const unsigned int *) vscr + 8 * 192;
+  for (y = 0; y < 192; y++)
+  {
+    for (x = 0; x < 8; x++)
+    {
+      input = *pinput++;
+      attrs = *pattrs++;
+
+      WRITE8PIX(0);
+      WRITE8PIX(8);
+      WRITE8PIX(16);
+      WRITE8PIX(24);
+    }
+    if ((y & 7) != 7)
+      pattrs -= 8;
+  }
+}
+
+/* Convert one 8x8 cell. */
+static void convert_cell(const uint8_t *screen,
+                         zxlayout_t     layout,
+                         int            row,
+                         int            column,
+                         unsigned int  *output)
+{
+  const unsigned int *pal;
+  unsigned int        attrs;
+  unsigned int        input;
+  int                 line;
+  int                 y;
+
+  attrs = screen[ZXSCREEN_BITMAP_LENGTH + row * 32 + column];
+  pal   = &palette[offsets[attrs & 0x7F]];
+  output += row * 8 * 256 + column * 8;
+  for (line = 0; line < 8; line++)
+  {
+    y = row * 8 + line;
+    if (layout == zxlayout_LINEAR)
+      input = screen[y * 32 + column];
+    else
+      input = screen[((y & 0xC0) << 5) |
+                     ((y & 0x07) << 8) |
+                     ((y & 0x38) << 2) | column];
+
+    output[0] = pal[(input >> 7) & 1];
+    output[1] = pal[(input >> 6) & 1];
+    output[2] = pal[(input >> 5) & 1];
+    output[3] = pal[(input >> 4) & 1];
+    output[4] = pal[(input >> 3) & 1];
+    output[5] = pal[(input >> 2) & 1];
+    output[6] = pal[(input >> 1) & 1];
+    output[7] = pal[(input >> 0) & 1];
+    output += 256;
+  }
+}
+
+int zxscreen_convert_changed(const void    *vscr,
+                             zxlayout_t     layout,
+                             void          *vshadow,
+                             unsigned int  *poutput)
+{
+  const uint8_t *screen = vscr;
+  uint8_t       *shadow = vshadow;
+  uint8_t        dirty[24 * 32]; /* Cells needing conversion */
+  int            offset;
+  int            cell;
+  int            converted;
+
+  memset(dirty, 0, sizeof(dirty));
+
+  /* Bitmap changes. Compare a word at a time, then find the bytes. Byte
+   * offset 0b000RRLLLrrrCCCCC belongs to cell row RRrrr, column CCCCC. In
+   * the linear layout, 0b000RRrrrLLLCCCCC does. */
+  for (offset = 0; offset < ZXSCREEN_BITMAP_LENGTH; offset += 4)
+  {
+    uint32_t a, b;
+    int      i;
+
+    memcpy(&a, screen + offset, 4);
+    memcpy(&b, shadow + offset, 4);
+    if (a == b)
+      continue;
+
+    for (i = 0; i < 4; i++)
+      if (screen[offset + i] != shadow[offset + i])
+      {
+        int o = offset + i;
+        if (layout == zxlayout_LINEAR)
+          dirty[(o >> 8) * 32 + (o & 31)] = 1;
+        else
+          dirty[(((o >> 11) << 3) | ((o >> 5) & 7)) * 32 + (o & 31)] = 1;
+      }
+  }
+
+  /* Attribute changes. These cells are recoloured from their unchanged
+   * bitmap. */
+  for (cell = 0; cell < 24 * 32; cell++)
+    if (screen[ZXSCREEN_BITMAP_LENGTH + cell] !=
+        shadow[ZXSCREEN_BITMAP_LENGTH + cell])
+      dirty[cell] = 1;
+
+  converted = 0;
+  for (cell = 0; cell < 24 * 32; cell++)
+    converted += dirty[cell];
+
+  if (converted >= WHOLE_SCREEN_CELLS)
+  {
+    /* Unchanged cells are reconverted to what they already show. */
+    if (layout == zxlayout_LINEAR)
+      zxscreen_convert_linear(screen, poutput);
+    else
+      zxscreen_convert(screen, poutput);
+  }
+  else if (converted)
+  {
+    for (cell = 0; cell < 24 * 32; cell++)
+      if (dirty[cell])
+        convert_cell(screen, layout, cell >> 5, cell & 31, poutput);
+  }
+
+  if (converted)
+    memcpy(shadow, screen, ZXSCREEN_LENGTH);
+
+  return converted;
+}
@@ -6,10 +6,23 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#define EXCHANGE(p, v) InterlockedExchange((p), (v))
+#else
+#define EXCHANGE(p, v) __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#endif
+
+#include "ZXSpectrum/Audio.h"
+#include "ZXSpectrum/Events.h"
+#include "ZXSpectrum/Keyboard.h"
+#include "ZXSpectrum/Pacer.h"
 #include "ZXSpectrum/Screen.h"
 
 #include "ZXSpectrum/Spectrum.h"
@@ -19,14 +32,156 @@ typedef struct zxspectrum_private
   zxspectrum_t        pub;
   zxconfig_t          config;
   
-  unsigned int       *screen; /* Converted screen */
+  /* Converted screens, triple buffered. The game thread converts into
+   * 'back' then swaps it with 'shared'. The presenter swaps 'front' with
+   * 'shared' when that holds a fresh frame. Neither side ever waits. */
+  unsigned int       *screens[3];
+  uint8_t            *shadows[3]; /* Screen data each was converted from */
+  int                 back;     /* Game thread only */
+  int                 front;    /* Presenter only */
+  volatile long       shared;   /* Index, plus SCREEN_FRESH if unclaimed */
+
+  uint64_t            clock;  /* Virtual clock, in T-states */
+  uint64_t            ahead;  /* T-states of sound not yet slept for */
+  zxaudio_t          *audio;  /* Beeper synthesiser */
+
+  zxevents_t         *events;   /* Posted input events */
+  zxkeyset_t          keys;     /* Keys held, as of the last latch */
+  uint8_t             kempston; /* Kempston bits held, as of the last latch */
+
+  zxpacer_t          *pacer;    /* Frame pacer, or NULL if unpaced */
+
+  void               *heap;     /* Block to release on destroy, or NULL if
+                                   the caller owns it */
 }
 zxspectrum_private_t;
 
-static uint8_t zx_in(zxspectrum_t *state, uint16_t address)
+/* Flag set in 'shared' when it holds a frame not yet claimed. */
+#define SCREEN_FRESH 4
+
+/* Length of a converted screen, in pixels. */
+#define SCREEN_PIXELS (256 * 192)
+
+/* Round up to a multiple of ZXSPECTRUM_ALIGNMENT. */
+#define ALIGN_UP(n) (((n) + ZXSPECTRUM_ALIGNMENT - 1) & ~(size_t) (ZXSPECTRUM_ALIGNMENT - 1))
+
+/* Offsets of the parts of a machine within its block. */
+typedef struct zxspectrum_layout
 {
-  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+  size_t screens;
+  size_t shadows;
+  size_t events;
+  size_t pacer;
+  size_t audio;
+  size_t total;
+}
+zxspectrum_layout_t;
 
+#ifdef ZXSPECTRUM_NO_HEAP
+/* Block used by zxspectrum_create. Over-allocated so it can be aligned. */
+static uint8_t static_block[ZXSPECTRUM_STATIC_FOOTPRINT + ZXSPECTRUM_ALIGNMENT - 1];
+static int     static_block_in_use;
+#endif
+
+/* Apply posted events to the held keys. */
+static void apply_events(zxspectrum_private_t *prv)
+{
+  const zxevent_t *event;
+  zxkeyset_t       keys_pressed;     /* Keys pressed by this batch */
+  uint8_t          kempston_pressed; /* Directions pressed by this batch */
+  zxkeyset_t       keybit;
+  uint8_t          kempstonbit;
+
+  keys_pressed     = 0;
+  kempston_pressed = 0;
+
+  while ((event = zxevents_peek(prv->events)) != NULL)
+  {
+    if (event->type == zxeventtype_KEY && event->index < zxkey__LIMIT)
+    {
+      keybit = 1ULL << event->index;
+      if (event->down)
+      {
+        prv->keys    |= keybit;
+        keys_pressed |= keybit;
+      }
+      else
+      {
+        if (keys_pressed & keybit)
+          break; /* Leave the release for the next latch. */
+        prv->keys &= ~keybit;
+      }
+    }
+    else if (event->type == zxeventtype_KEMPSTON &&
+             event->index <= zxkempston_FIRE)
+    {
+      kempstonbit = 1 << event->index;
+      if (event->down)
+      {
+        prv->kempston    |= kempstonbit;
+        kempston_pressed |= kempstonbit;
+      }
+      else
+      {
+        if (kempston_pressed & kempstonbit)
+          break; /* Leave the release for the next latch. */
+        prv->kempston &= ~kempstonbit;
+      }
+    }
+
+    zxevents_pop(prv->events);
+  }
+}
+
+/* Latch all of the input ports into the snapshot. */
+static void latch_input(zxspectrum_private_t *prv)
+{
+  zxinput_t *input = &prv->pub.input;
+  int        row;
+  uint16_t   port;
+  uint8_t    bits;
+
+  apply_events(prv);
+
+  for (row = 0; row < 8; row++)
+  {
+    port = (uint16_t) ((~(0x100 << row) & 0xFF00) | 0xFE);
+    bits = zxkeyset_for_port(port, prv->keys);
+    if (prv->config.key)
+      bits &= prv->config.key(port, prv->config.opaque);
+    input->keyboard[row] = bits;
+  }
+
+  input->kempston = prv->kempston;
+  input->fuller   = 0xFF;
+}
+
+uint8_t zxinput_read(const zxinput_t *input, uint16_t port)
+{
+  uint8_t hi;
+  uint8_t bits;
+  int     row;
+
+  assert(input != NULL);
+
+  if (port == port_KEMPSTON_JOYSTICK)
+    return input->kempston;
+  if (port == port_FULLER_JOYSTICK)
+    return input->fuller;
+
+  assert((port & 1) == 0); /* ULA ports only from here on */
+
+  hi   = port >> 8;
+  bits = 0xFF;
+  for (row = 0; row < 8; row++)
+    if ((hi & (1 << row)) == 0)
+      bits &= input->keyboard[row];
+
+  return bits;
+}
+
+static uint8_t zx_in(zxspectrum_t *state, uint16_t address)
+{
   switch (address)
   {
     case port_KEYBOARD_12345:
@@ -37,10 +192,9 @@ static uint8_t zx_in(zxspectrum_t *state, uint16_t address)
     case port_KEYBOARD_ENTERLKJH:
     case port_KEYBOARD_SHIFTZXCV:
     case port_KEYBOARD_SPACESYMSHFTMNB:
-      return prv->config.key(address, prv->config.opaque);
-
     case port_KEMPSTON_JOYSTICK:
-      return 0x00;
+    case port_FULLER_JOYSTICK:
+      return zxinput_read(&state->input, address);
 
     default:
       assert("zx_in not implemented for that port" == NULL);
@@ -50,9 +204,13 @@ static uint8_t zx_in(zxspectrum_t *state, uint16_t address)
 
 static void zx_out(zxspectrum_t *state, uint16_t address, uint8_t byte)
 {
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
   switch (address)
   {
     case port_BORDER:
+      /* Timestamp the speaker (EAR) edge. Border colour is ignored. */
+      zxaudio_speaker(prv->audio, prv->clock, (byte >> 4) & 1);
       break;
       
     default:
@@ -61,13 +219,85 @@ static void zx_out(zxspectrum_t *state, uint16_t address, uint8_t byte)
   }
 }
 
+/* Advance the virtual clock by a real-time wait. Sound played since the last
+ * wait has already moved the clock on, so only the remainder is added. This
+ * keeps the clock in step with real time when the game plays sound then
+ * waits, as the menu does every frame. */
+static void advance_clock(zxspectrum_private_t *prv, uint64_t tstates)
+{
+  if (prv->ahead >= tstates)
+  {
+    prv->ahead -= tstates;
+  }
+  else
+  {
+    prv->clock += tstates - prv->ahead;
+    prv->ahead  = 0;
+  }
+  zxaudio_advance(prv->audio, prv->clock);
+}
+
+/* Wait for the current frame's deadline and decide whether the next frame
+ * should be rendered. */
+static void pace_frame(zxspectrum_private_t *prv)
+{
+  int wait;
+  int period;
+
+  prv->pub.frame_skip = zxpacer_end_frame(prv->pacer, &wait);
+  if (wait > 0)
+    prv->config.sleep(wait, sleeptype_FRAME, prv->config.opaque);
+  zxpacer_start_frame(prv->pacer);
+
+  period = zxpacer_period(prv->pacer);
+  advance_clock(prv, (uint64_t) period * (ZXAUDIO_CLOCK_RATE / 1000) / 1000);
+}
+
+/* Convert and present the screen, unless this frame skips rendering. */
+static void present(zxspectrum_private_t *prv)
+{
+  unsigned int *pixels;
+
+  if (prv->pub.frame_skip)
+    return;
+
+  pixels = prv->screens[prv->back];
+
+  /* Only cells whose bitmap or attributes changed since this buffer was
+   * last converted are repainted. */
+  zxscreen_convert_changed(prv->pub.screen,
+                           prv->pub.layout,
+                           prv->shadows[prv->back],
+                           pixels);
+
+  /* Publish the frame and take back whichever buffer was shared. */
+  prv->back = EXCHANGE(&prv->shared, prv->back | SCREEN_FRESH) & 3;
+
+  prv->config.draw(pixels, prv->config.opaque);
+}
+
 static void zx_kick(zxspectrum_t *state)
 {
   zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
-  
-  zxscreen_convert(prv->pub.screen, prv->screen);
 
-  prv->config.draw(prv->screen, prv->config.opaque);
+  /* Kicks come mid-frame too, e.g. once per searchlight at night, after the
+   * game has read its input. Latching here could apply a press then leave
+   * its release for the frame's end, so the game would never see the key. */
+  present(prv);
+}
+
+static void zx_end_frame(zxspectrum_t *state)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
+  present(prv);
+
+  /* Only whole frames are paced: the game kicks mid-frame too, e.g. once
+   * per searchlight at night. */
+  if (prv->pacer)
+    pace_frame(prv);
+
+  latch_input(prv);
 }
 
 static void zx_sleep(zxspectrum_t *state,
@@ -75,46 +305,253 @@ static void zx_sleep(zxspectrum_t *state,
                      int           duration)
 {
   zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+  uint64_t              tstates;
+
+  if (sleeptype == sleeptype_SOUND)
+  {
+    /* Sound delays are Z80 delay loop counts: DEC C; JR NZ is 16 T-states
+     * per iteration. Advance the virtual clock only - the beeper is
+     * synthesised from the timestamped edges so there's no need to block
+     * the game. */
+    tstates = (uint64_t) duration * 16;
+    prv->clock += tstates;
+    prv->ahead += tstates;
+    zxaudio_advance(prv->audio, prv->clock);
+    return;
+  }
+
+  if (prv->pacer)
+  {
+    /* The pacer sets the frame rate, so the game's own delays are moot. */
+    if (sleeptype == sleeptype_DELAY)
+      return;
+
+    /* Waiting for input puts us off schedule. */
+    zxpacer_resync(prv->pacer);
+  }
+
+  /* Other durations are in microseconds. */
+  tstates = (uint64_t) duration * (ZXAUDIO_CLOCK_RATE / 1000) / 1000;
+  advance_clock(prv, tstates);
 
   prv->config.sleep(duration, sleeptype, prv->config.opaque);
+
+  /* Waits for input see fresh inputs. Delays made mid-frame don't. */
+  if (sleeptype == sleeptype_MENU || sleeptype == sleeptype_KEYSCAN)
+    latch_input(prv);
+}
+
+static void layout(const zxconfig_t *config, zxspectrum_layout_t *l)
+{
+  size_t offset;
+
+  offset     = ALIGN_UP(sizeof(zxspectrum_private_t));
+  l->screens = offset;
+  offset    += ALIGN_UP(3 * SCREEN_PIXELS * sizeof(unsigned int));
+  l->shadows = offset;
+  offset    += ALIGN_UP(3 * ZXSCREEN_LENGTH);
+  l->events  = offset;
+  offset    += ALIGN_UP(zxevents_footprint());
+  l->pacer   = offset;
+  if (config->frame_rate > 0)
+    offset  += ALIGN_UP(zxpacer_footprint());
+  l->audio   = offset;
+  offset    += ALIGN_UP(zxaudio_footprint());
+  l->total   = offset;
+}
+
+/* Returns p rounded up to ZXSPECTRUM_ALIGNMENT. */
+static void *align_block(void *p)
+{
+  return (void *) ALIGN_UP((uintptr_t) p);
+}
+
+size_t zxspectrum_footprint(const zxconfig_t *config)
+{
+  zxspectrum_layout_t l;
+
+  assert(config != NULL);
+
+  layout(config, &l);
+
+  return l.total;
 }
 
 zxspectrum_t *zxspectrum_create(const zxconfig_t *config)
 {
+  size_t        footprint;
+  void         *heap;
+  zxspectrum_t *speccy;
+
+  footprint = zxspectrum_footprint(config);
+
+#ifdef ZXSPECTRUM_NO_HEAP
+  if (static_block_in_use || footprint > ZXSPECTRUM_STATIC_FOOTPRINT)
+    return NULL;
+  heap = static_block;
+#else
+  heap = malloc(footprint + ZXSPECTRUM_ALIGNMENT - 1);
+  if (heap == NULL)
+    return NULL;
+#endif
+
+  speccy = zxspectrum_create_in(config, align_block(heap), footprint);
+  if (speccy == NULL)
+  {
+#ifndef ZXSPECTRUM_NO_HEAP
+    free(heap);
+#endif
+    return NULL;
+  }
+
+#ifdef ZXSPECTRUM_NO_HEAP
+  static_block_in_use = 1;
+#endif
+  ((zxspectrum_private_t *) speccy)->heap = heap;
+
+  return speccy;
+}
+
+zxspectrum_t *zxspectrum_create_in(const zxconfig_t *config,
+                                   void             *block,
+                                   size_t            size)
+{
+  zxspectrum_layout_t   l;
+  uint8_t              *base = block;
   zxspectrum_private_t *prv;
-  
-  prv = malloc(sizeof(*prv));
-  if (prv == NULL)
+
+  assert(config != NULL);
+  assert(block != NULL);
+  assert(((uintptr_t) block & (ZXSPECTRUM_ALIGNMENT - 1)) == 0);
+
+  layout(config, &l);
+  if (size < l.total)
     return NULL;
 
-  prv->pub.in    = zx_in;
-  prv->pub.out   = zx_out;
-  prv->pub.kick  = zx_kick;
-  prv->pub.sleep = zx_sleep;
+  /* Zeroed screen data and shadows describe zeroed (black) screens. */
+  memset(block, 0, l.total);
+
+  prv = (zxspectrum_private_t *) base;
+  prv->heap = NULL;
+
+  prv->pub.in        = zx_in;
+  prv->pub.out       = zx_out;
+  prv->pub.kick      = zx_kick;
+  prv->pub.end_frame = zx_end_frame;
+  prv->pub.sleep     = zx_sleep;
 
   prv->config = *config;
+
+  prv->pub.layout = config->layout;
+
+  /* Input: nothing pressed until the first latch. */
+
+  memset(prv->pub.input.keyboard, 0xFF, sizeof(prv->pub.input.keyboard));
+  prv->pub.input.kempston = 0x00;
+  prv->pub.input.fuller   = 0xFF;
   
-  /* Converted screen */
-  
-  prv->screen = malloc(256 * 192 * sizeof(*prv->screen));
-  if (prv->screen == NULL)
-  {
-    free(prv);
+  /* Converted screens */
+
+  prv->screens[0] = (unsigned int *) (base + l.screens);
+  prv->screens[1] = prv->screens[0] + SCREEN_PIXELS;
+  prv->screens[2] = prv->screens[1] + SCREEN_PIXELS;
+
+  /* Shadows */
+
+  prv->shadows[0] = base + l.shadows;
+  prv->shadows[1] = prv->shadows[0] + ZXSCREEN_LENGTH;
+  prv->shadows[2] = prv->shadows[1] + ZXSCREEN_LENGTH;
+  prv->front  = 0;
+  prv->shared = 1;
+  prv->back   = 2;
+
+  /* Input events */
+
+  prv->keys     = 0;
+  prv->kempston = 0;
+  prv->events   = zxevents_init(base + l.events);
+  if (prv->events == NULL)
     return NULL;
-  }
-  
-  zxscreen_initialise();
+
+  /* Frame pacer */
+
+  prv->pub.frame_skip = 0;
+  prv->pacer = NULL;
+  if (config->frame_rate > 0)
+    prv->pacer = zxpacer_init(base + l.pacer, config->frame_rate);
+
+  /* Beeper */
+
+  prv->clock = 0;
+  prv->ahead = 0;
+  prv->audio = zxaudio_init(base + l.audio);
 
   return &prv->pub;
 }
 
 void zxspectrum_destroy(zxspectrum_t *doomed)
 {
+  zxspectrum_private_t *prv;
+  void                 *heap;
+
   if (doomed == NULL)
     return;
   
-  zxspectrum_private_t *prv = (zxspectrum_private_t *) doomed;
+  prv = (zxspectrum_private_t *) doomed;
+
+  zxevents_finalise(prv->events);
+
+  heap = prv->heap;
+#ifdef ZXSPECTRUM_NO_HEAP
+  if (heap)
+    static_block_in_use = 0;
+#else
+  free(heap);
+#endif
+}
+
+int zxspectrum_post_event(zxspectrum_t *state, const zxevent_t *event)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
+  return zxevents_push(prv->events, event);
+}
+
+int zxspectrum_wait_for_event(zxspectrum_t *state, int timeout)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
+  return zxevents_wait(prv->events, timeout);
+}
+
+const unsigned int *zxspectrum_claim_screen(zxspectrum_t *state)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
+  if (prv->shared & SCREEN_FRESH)
+    prv->front = EXCHANGE(&prv->shared, prv->front) & 3;
+
+  return prv->screens[prv->front];
+}
+
+void zxspectrum_get_pacer_stats(zxspectrum_t *state, zxpacerstats_t *stats)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
+
+  if (prv->pacer == NULL)
+  {
+    memset(stats, 0, sizeof(*stats));
+    return;
+  }
+
+  zxpacer_get_stats(prv->pacer, stats);
+}
+
+int zxspectrum_read_audio(zxspectrum_t *state,
+                          int16_t      *samples,
+                          int           nsamples)
+{
+  zxspectrum_private_t *prv = (zxspectrum_private_t *) state;
 
-  free(prv->screen);
-  free(prv);
+  return zxaudio_read(prv->audio, samples, nsamples);
 }
@@ -1,8 +1,744 @@
+/* main.c
+ *
+ * Headless fork-server launcher for The Great Escape.
+ *
+ * One game is set up to start in play, optionally run on for a number of
+ * frames, then each job read from stdin is run in a forked worker. Workers
+ * start from a copy-on-write image of that game so all the pages they don't
+ * write to (the static tables and most of the state) stay shared. Each
+ * reports its result back over a pipe, and a crash in one only loses that
+ * job.
+ *
+ * The game's graphics and level data can come from an asset pack, which
+ * separate launchers then share. "-p <pack>" writes one and exits.
+ *
+ * "-c <frames>" instead runs checks at night, when the searchlights present
+ * mid-frame. It runs that many paced frames and fails unless they take about
+ * as many frame periods. Then it taps a direction, pressed and released
+ * between two frames, and fails unless the game reads it. Last it plays
+ * the same walk in a game rendering every frame and in one skipping
+ * frames, from the start of play until that many frames after nightfall,
+ * and fails unless their states match after every frame.
+ *
+ * Jobs are lines of "<frames> <seed>": run that many frames while walking
+ * the hero about in a direction picked from seed every WALK_PERIOD frames.
+ * Results are written to stdout as lines of:
+ *
+ *   <job> ok <room> <morale> <clock> <hero x> <hero y> <hero height>
+ *   <job> crashed <signal>
+ *   <job> failed
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ZXSpectrum/Spectrum.h"
+#include "ZXSpectrum/Keyboard.h"
+
+#include "TheGreatEscape/TheGreatEscape.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define WIDTH  256
+#define HEIGHT 192
+
+/* Default limit on the number of workers running at once. */
+#define DEFAULT_WORKERS 4
+
+/* Frames between the walk's changes of direction. */
+#define WALK_PERIOD 25
+
+/* Frame rate used by the pacing check. */
+#define CHECK_RATE 200
+
+/* Frames to run while waiting for night before the pacing check gives up. */
+#define CHECK_MAX_WARMUP 20000
+
+/* Render interval compared against rendering every frame. */
+#define CHECK_RENDER_INTERVAL 3
+
+/* Seed of the walk played by the render interval check. Most walks leave
+ * the huts, and door_handling_interior then lands the hero at the wrong
+ * door position, which fails an assertion in reset_outdoors. This one stays
+ * indoors. */
+#define CHECK_WALK_SEED 7
+
+typedef struct launcher
+{
+  zxspectrum_t *zx;
+  tgestate_t   *tge;
+  int           pacing;       /* whether to wait for frame deadlines */
+  int           frame_waits;  /* frame deadlines waited for */
+  int           draws;        /* frames presented */
+}
+launcher_t;
+
+typedef struct job
+{
+  int      id;
+  int      frames;
+  unsigned seed;
+}
+job_t;
+
+typedef struct result
+{
+  job_t            job;
+  tgeobservation_t obs;
+}
+result_t;
+
+typedef struct worker
+{
+  pid_t pid; /* or zero if the slot is free */
+  int   fd;  /* read end of the worker's result pipe */
+  job_t job;
+}
+worker_t;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void draw_handler(unsigned int *pixels, void *opaque)
+{
+  launcher_t *launcher = opaque;
+
+  // headless: nothing to present, but the checks count presents
+  (void) pixels;
+
+  launcher->draws++;
+}
+
+static void sleep_handler(int duration, sleeptype_t sleeptype, void *opaque)
+{
+  launcher_t     *launcher = opaque;
+  struct timespec ts;
+
+  // headless: nothing to wait for, unless checking the pacer
+  if (sleeptype != sleeptype_FRAME || !launcher->pacing)
+    return;
+
+  launcher->frame_waits++;
+
+  ts.tv_sec  = duration / 1000000;
+  ts.tv_nsec = (long) (duration % 1000000) * 1000;
+  while (nanosleep(&ts, &ts) < 0 && errno == EINTR)
+    ;
+}
+
+static int64_t now_us(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void post_kempston(launcher_t   *launcher,
+                          int           frame,
+                          zxkempston_t  direction,
+                          bool          down)
+{
+  zxevent_t event;
+
+  event.timestamp = (uint32_t) frame;
+  event.type      = zxeventtype_KEMPSTON;
+  event.index     = (uint8_t) direction;
+  event.down      = down;
+  zxspectrum_post_event(launcher->zx, &event);
+}
+
+/* Walk the hero about: every WALK_PERIOD frames let go of the last
+ * direction and press one picked from rng. */
+static void walk(launcher_t   *launcher,
+                 int           frame,
+                 unsigned int *rng,
+                 int          *direction)
+{
+  if (frame % WALK_PERIOD != 0)
+    return;
+
+  if (*direction >= 0)
+    post_kempston(launcher, frame, (zxkempston_t) *direction, false);
+  *rng = *rng * 1103515245 + 12345;
+  *direction = (int) ((*rng >> 16) % 4); // right, left, down or up
+  post_kempston(launcher, frame, (zxkempston_t) *direction, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int write_all(int fd, const void *buf, size_t length)
+{
+  const char *p = buf;
+  ssize_t     n;
+
+  while (length > 0)
+  {
+    n = write(fd, p, length);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1;
+    p      += n;
+    length -= (size_t) n;
+  }
+
+  return 0;
+}
+
+static int read_all(int fd, void *buf, size_t length)
+{
+  char   *p = buf;
+  ssize_t n;
+
+  while (length > 0)
+  {
+    n = read(fd, p, length);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return -1; // error, or the worker died before reporting
+    p      += n;
+    length -= (size_t) n;
+  }
+
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/* Runs in the worker. */
+static void run_job(launcher_t *launcher, const job_t *job, int fd)
+{
+  result_t     result;
+  unsigned int rng;
+  int          frame;
+  int          direction;
+
+  rng       = job->seed;
+  direction = -1;
+  for (frame = 0; frame < job->frames; frame++)
+  {
+    walk(launcher, frame, &rng, &direction);
+    tge_main(launcher->tge);
+  }
+
+  memset(&result, 0, sizeof(result));
+  result.job = *job;
+  tge_observe(launcher->tge, &result.obs);
+
+  (void) write_all(fd, &result, sizeof(result));
+}
+
+static int start_worker(launcher_t *launcher, worker_t *worker, const job_t *job)
+{
+  int   fds[2];
+  pid_t pid;
+
+  if (pipe(fds) < 0)
+    return -1;
+
+  // anything buffered would otherwise be written out by the worker too
+  fflush(stdout);
+
+  pid = fork();
+  if (pid < 0)
+  {
+    close(fds[0]);
+    close(fds[1]);
+    return -1;
+  }
+
+  if (pid == 0)
+  {
+    close(fds[0]);
+    run_job(launcher, job, fds[1]);
+    _exit(EXIT_SUCCESS);
+  }
+
+  close(fds[1]);
+
+  worker->pid = pid;
+  worker->fd  = fds[0];
+  worker->job = *job;
+
+  return 0;
+}
+
+/* Wait for any worker to finish and print its result. Returns 1 if a
+ * worker's slot was freed, 0 if some other child was reaped, or -1 if there
+ * was nothing to wait for. */
+static int reap_worker(worker_t *workers, int nworkers)
+{
+  pid_t                   pid;
+  int                     status;
+  int                     i;
+  worker_t               *worker;
+  result_t                result;
+  const tgeobservation_t *obs;
+
+  do
+    pid = waitpid(-1, &status, 0);
+  while (pid < 0 && errno == EINTR);
+  if (pid < 0)
+    return -1; // e.g. ECHILD: our workers were reaped elsewhere
+
+  worker = NULL;
+  for (i = 0; i < nworkers; i++)
+    if (workers[i].pid == pid)
+      worker = &workers[i];
+  if (worker == NULL)
+    return 0;
+
+  if (WIFSIGNALED(status))
+  {
+    printf("%d crashed %d\n", worker->job.id, WTERMSIG(status));
+  }
+  else if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS &&
+           read_all(worker->fd, &result, sizeof(result)) == 0)
+  {
+    obs = &result.obs;
+    printf("%d ok %d %d %d %d %d %d\n",
+           result.job.id,
+           obs->room,
+           obs->morale,
+           obs->clock,
+           obs->vischars[0].x,
+           obs->vischars[0].y,
+           obs->vischars[0].height);
+  }
+  else
+  {
+    printf("%d failed\n", worker->job.id);
+  }
+
+  close(worker->fd);
+  worker->pid = 0;
 
-int main(void)
+  return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/* Set up a game for a check, ready to play. Returns 0 on success. */
+static int open_check(launcher_t        *launcher,
+                      const tgeconfig_t *tgeconfig,
+                      int                frame_rate)
+{
+  zxconfig_t zxconfig;
+
+  memset(launcher, 0, sizeof(*launcher));
+
+  zxconfig.opaque     = launcher;
+  zxconfig.draw       = draw_handler;
+  zxconfig.sleep      = sleep_handler;
+  zxconfig.key        = NULL;
+  zxconfig.frame_rate = frame_rate;
+  zxconfig.layout     = zxlayout_LINEAR;
+
+  launcher->zx = zxspectrum_create(&zxconfig);
+  if (launcher->zx == NULL)
+    return -1;
+
+  launcher->tge = tge_create(launcher->zx, tgeconfig);
+  if (launcher->tge == NULL)
+    return -1;
+
+  tge_setup(launcher->tge);
+
+  return 0;
+}
+
+/* Set up a game for a check and run it on until night without waiting.
+ * Returns 0 on success. */
+static int start_check(launcher_t        *launcher,
+                       const tgeconfig_t *tgeconfig,
+                       int                frame_rate)
+{
+  tgeobservation_t obs;
+  int              i;
+
+  if (open_check(launcher, tgeconfig, frame_rate) < 0)
+    return -1;
+
+  for (i = 0; i < CHECK_MAX_WARMUP; i++)
+  {
+    tge_observe(launcher->tge, &obs);
+    if (obs.day_or_night)
+      return 0;
+    tge_main(launcher->tge);
+  }
+
+  fprintf(stderr, "Night never came.\n");
+  return -1;
+}
+
+static void stop_check(launcher_t *launcher)
+{
+  tge_destroy(launcher->tge);
+  zxspectrum_destroy(launcher->zx);
+}
+
+/* Check that paced frames at night each take one frame period: the
+ * searchlights present mid-frame and only the end of a frame may wait.
+ * Returns 0 on success. */
+static int check_pacing(const tgeconfig_t *tgeconfig, int frames)
+{
+  launcher_t launcher;
+  int        i;
+  int        waits;
+  int        overpaced;
+  int64_t    start;
+  double     periods;
+
+  if (start_check(&launcher, tgeconfig, CHECK_RATE) < 0)
+    return -1;
+
+  // a wait for input puts the pacer back on schedule
+  launcher.zx->sleep(launcher.zx, sleeptype_KEYSCAN, 0);
+  launcher.pacing = 1;
+
+  overpaced = 0;
+  start     = now_us();
+  for (i = 0; i < frames; i++)
+  {
+    waits = launcher.frame_waits;
+    tge_main(launcher.tge);
+    if (launcher.frame_waits - waits > 1)
+      overpaced++;
+  }
+  periods = (double) (now_us() - start) * CHECK_RATE / 1000000;
+
+  printf("%d night frames took %.1f frame periods; %d waited more than once\n",
+         frames,
+         periods,
+         overpaced);
+
+  stop_check(&launcher);
+
+  // allow for the last frame's work and some scheduling slop
+  return (overpaced == 0 && periods < frames * 1.1 + 2) ? 0 : -1;
+}
+
+/* Check that a direction pressed and released between two frames is read
+ * by the game, even when a searchlight presents mid-frame after the input
+ * was read. Returns 0 on success. */
+static int check_tap(const tgeconfig_t *tgeconfig)
+{
+  launcher_t       launcher;
+  tgeobservation_t obs;
+  int              i;
+  int              draws;
+  int              seen;
+
+  if (start_check(&launcher, tgeconfig, 0) < 0)
+    return -1;
+
+  /* Find a frame which presents mid-frame while the hero has no input. */
+  for (i = 0; i < CHECK_MAX_WARMUP; i++)
+  {
+    draws = launcher.draws;
+    tge_main(launcher.tge);
+    tge_observe(launcher.tge, &obs);
+    if (launcher.draws - draws > 1 && obs.vischars[0].input == 0)
+      break;
+  }
+  if (i == CHECK_MAX_WARMUP)
+  {
+    fprintf(stderr, "No frame presented mid-frame.\n");
+    stop_check(&launcher);
+    return -1;
+  }
+
+  // both events arrive in one batch
+  post_kempston(&launcher, 0, zxkempston_LEFT, true);
+  post_kempston(&launcher, 0, zxkempston_LEFT, false);
+
+  /* The tap is latched at the end of the next frame and must be read in
+   * the one after. */
+  seen = 0;
+  for (i = 0; i < 2 && !seen; i++)
+  {
+    tge_main(launcher.tge);
+    tge_observe(launcher.tge, &obs);
+    seen = obs.vischars[0].input != 0;
+  }
+
+  printf("tap at night was %s\n", seen ? "read" : "lost");
+
+  stop_check(&launcher);
+
+  return seen ? 0 : -1;
+}
+
+/* Check that skipping rendering doesn't change the game: play the same walk
+ * in two games, one rendering every frame and one every
+ * CHECK_RENDER_INTERVAL frames, and compare them after every frame until
+ * the given number of frames after nightfall. Returns 0 on success. */
+static int check_render(const tgeconfig_t *tgeconfig, int frames)
+{
+  launcher_t       every;
+  launcher_t       skipping;
+  tgeobservation_t obs;
+  unsigned int     rng[2];
+  int              direction[2];
+  int              frame;
+  int              night;
+  int              differed;
+
+  if (open_check(&every, tgeconfig, 0) < 0)
+    return -1;
+  if (open_check(&skipping, tgeconfig, 0) < 0)
+  {
+    stop_check(&every);
+    return -1;
+  }
+
+  tge_set_render_interval(skipping.tge, CHECK_RENDER_INTERVAL);
+
+  rng[0] = rng[1] = CHECK_WALK_SEED;
+  direction[0] = direction[1] = -1;
+  night    = -1;
+  differed = 0;
+  for (frame = 0; frame < CHECK_MAX_WARMUP + frames; frame++)
+  {
+    walk(&every, frame, &rng[0], &direction[0]);
+    walk(&skipping, frame, &rng[1], &direction[1]);
+    tge_main(every.tge);
+    tge_main(skipping.tge);
+
+    if (tge_compare(every.tge, skipping.tge) != 0)
+    {
+      differed = 1;
+      break;
+    }
+
+    if (night < 0)
+    {
+      tge_observe(every.tge, &obs);
+      if (obs.day_or_night)
+        night = frame;
+    }
+    else if (frame - night >= frames)
+    {
+      break;
+    }
+  }
+
+  if (differed)
+    printf("rendering every %d frames changed the game at frame %d\n",
+           CHECK_RENDER_INTERVAL,
+           frame);
+  else
+    printf("rendering every %d frames matched over %d frames\n",
+           CHECK_RENDER_INTERVAL,
+           frame);
+
+  stop_check(&skipping);
+  stop_check(&every);
+
+  return (differed || night < 0) ? -1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void usage(const char *name)
 {
-  printf("Stub main\n");
+  fprintf(stderr,
+          "Usage: %s [-w frames] [-j workers] [-a pack]\n"
+          "       %s -p pack\n"
+          "       %s -c frames\n"
+          "  -w frames   run the game on this many frames before forking\n"
+          "  -j workers  run at most this many workers at once (default %d)\n"
+          "  -a pack     use the graphics and level data in this asset pack\n"
+          "  -p pack     write an asset pack and exit\n"
+          "  -c frames   check pacing and rendering over this many frames, and\n"
+          "              input, then exit\n"
+          "Reads jobs of \"<frames> <seed>\" from stdin.\n",
+          name,
+          name,
+          name,
+          DEFAULT_WORKERS);
+}
+
+int main(int argc, char *argv[])
+{
+  static const tgeconfig_t tgeconfig =
+  {
+    WIDTH  / 8,
+    HEIGHT / 8,
+    1, // skip transitions: nothing sees them
+    1, // skip the menu
+    1, // Kempston joystick
+    { zxkey_UNKNOWN } // keys are unused
+  };
+
+  launcher_t  launcher;
+  zxconfig_t  zxconfig;
+  const char *pack;
+  int         warmup;
+  int         nworkers;
+  worker_t  *workers;
+  int        active;
+  int        reaped;
+  int        opt;
+  int        i;
+  char       line[128];
+  job_t      job;
+
+  warmup   = 0;
+  nworkers = DEFAULT_WORKERS;
+  pack     = NULL;
+  while ((opt = getopt(argc, argv, "w:j:a:p:c:")) != -1)
+  {
+    switch (opt)
+    {
+    case 'w':
+      warmup = atoi(optarg);
+      break;
+    case 'j':
+      nworkers = atoi(optarg);
+      break;
+    case 'a':
+      pack = optarg;
+      break;
+    case 'p':
+      if (!tge_write_assets(optarg))
+      {
+        fprintf(stderr, "Couldn't write asset pack %s.\n", optarg);
+        exit(EXIT_FAILURE);
+      }
+      exit(EXIT_SUCCESS);
+    case 'c':
+      if (check_pacing(&tgeconfig, atoi(optarg)) < 0)
+      {
+        fprintf(stderr, "Frame pacing check failed.\n");
+        exit(EXIT_FAILURE);
+      }
+      if (check_tap(&tgeconfig) < 0)
+      {
+        fprintf(stderr, "Input tap check failed.\n");
+        exit(EXIT_FAILURE);
+      }
+      if (check_render(&tgeconfig, atoi(optarg)) < 0)
+      {
+        fprintf(stderr, "Render interval check failed.\n");
+        exit(EXIT_FAILURE);
+      }
+      exit(EXIT_SUCCESS);
+    default:
+      usage(argv[0]);
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (warmup < 0 || nworkers < 1)
+  {
+    usage(argv[0]);
+    exit(EXIT_FAILURE);
+  }
+
+  workers = calloc((size_t) nworkers, sizeof(*workers));
+  if (workers == NULL)
+    goto failure;
+
+  // without the pack the compiled-in data is used
+  if (pack && !tge_load_assets(pack))
+    fprintf(stderr, "Couldn't use asset pack %s.\n", pack);
+
+  /* Set up the one game which every worker starts from. */
+
+  memset(&launcher, 0, sizeof(launcher));
+
+  zxconfig.opaque     = &launcher;
+  zxconfig.draw       = draw_handler;
+  zxconfig.sleep      = sleep_handler;
+  zxconfig.key        = NULL; // keys are posted as events
+  zxconfig.frame_rate = 0; // unpaced: run as fast as possible
+  zxconfig.layout     = zxlayout_LINEAR; // nothing needs the real layout
+
+  launcher.zx = zxspectrum_create(&zxconfig);
+  if (launcher.zx == NULL)
+    goto failure;
+
+  launcher.tge = tge_create(launcher.zx, &tgeconfig);
+  if (launcher.tge == NULL)
+    goto failure;
+
+  // the game window is only needed by a frontend
+  tge_set_render_interval(launcher.tge, 0);
+
+  tge_setup(launcher.tge);
+
+  // we arrive here ready to play
+
+  for (i = 0; i < warmup; i++)
+    tge_main(launcher.tge);
+
+  /* Serve jobs. */
+
+  active = 0;
+  job.id = 0;
+  while (fgets(line, sizeof(line), stdin))
+  {
+    if (sscanf(line, "%d %u", &job.frames, &job.seed) != 2 || job.frames < 0)
+    {
+      fprintf(stderr, "Bad job: %s", line);
+      continue;
+    }
+
+    while (active == nworkers)
+    {
+      reaped = reap_worker(workers, nworkers);
+      if (reaped < 0)
+        goto lost_workers;
+      active -= reaped;
+    }
+
+    for (i = 0; i < nworkers; i++)
+      if (workers[i].pid == 0)
+        break;
+
+    if (start_worker(&launcher, &workers[i], &job) < 0)
+      printf("%d failed\n", job.id);
+    else
+      active++;
+
+    job.id++;
+  }
+
+  while (active > 0)
+  {
+    reaped = reap_worker(workers, nworkers);
+    if (reaped < 0)
+      goto lost_workers;
+    active -= reaped;
+  }
+
+  tge_destroy(launcher.tge);
+  zxspectrum_destroy(launcher.zx);
+  tge_unload_assets();
+  free(workers);
+
   exit(EXIT_SUCCESS);
+
+
+failure:
+  fprintf(stderr, "Couldn't set up the game.\n");
+  exit(EXIT_FAILURE);
+
+
+lost_workers:
+  fprintf(stderr, "Couldn't wait for workers: %s\n", strerror(errno));
+  exit(EXIT_FAILURE);
 }
+
+// vim: ts=8 sts=2 sw=2 et
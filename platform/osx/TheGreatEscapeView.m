@@ -41,10 +41,9 @@
   zxspectrum_t *zx;
   tgestate_t   *game;
   
-  unsigned int *pixels;
+  const unsigned int *pixels;
   float         scale;
   pthread_t     thread;
-  zxkeyset_t    keys;
 }
 
 @end
@@ -64,14 +63,34 @@ static void draw_handler(unsigned int *pixels, void *opaque)
 
 static void sleep_handler(int duration, sleeptype_t sleeptype, void *opaque)
 {
+  TheGreatEscapeView *view = (__bridge TheGreatEscapeView *) opaque;
+
+  // Waits for input end as soon as a key is posted
+  if (sleeptype == sleeptype_KEYSCAN)
+  {
+    (void) zxspectrum_wait_for_event(view->zx, duration);
+    return;
+  }
+
   usleep(duration); // duration is taken literally for now
 }
 
-static int key_handler(uint16_t port, void *opaque)
+// -----------------------------------------------------------------------------
+
+#pragma mark - UI thread
+
+static void post_key(zxspectrum_t *zx, NSEvent *event, zxkey_t key, bool down)
 {
-  TheGreatEscapeView *viewptr = (__bridge id) opaque;
+  zxevent_t zxevent;
 
-  return zxkeyset_for_port(port, viewptr->keys);
+  if (key == zxkey_UNKNOWN)
+    return;
+
+  zxevent.timestamp = (uint32_t) ([event timestamp] * 1000.0); // ms
+  zxevent.type      = zxeventtype_KEY;
+  zxevent.index     = (uint8_t) key;
+  zxevent.down      = down;
+  zxspectrum_post_event(zx, &zxevent);
 }
 
 // -----------------------------------------------------------------------------
@@ -100,7 +119,9 @@ static void *tge_thread(void *arg)
 
 - (void)setPixels:(unsigned int *)data
 {
-  pixels = data;
+  // Don't hang on to data: it's only valid for the duration of the draw
+  // callback. drawRect claims the latest frame instead.
+  (void) data;
 
   // Odd: This refreshes the whole window no matter what size of rect is specified
   [self setNeedsDisplayInRect:NSMakeRect(0, 0, WIDTH * scale, HEIGHT * scale)];
@@ -113,7 +134,9 @@ static void *tge_thread(void *arg)
     (__bridge void *)(self),
     &draw_handler,
     &sleep_handler,
-    &key_handler,
+    NULL, // keys are posted as events
+    0,    // unpaced: the game's own delays set its speed
+    zxlayout_SPECTRUM
   };
 
   /* Configuration of The Great Escape instance. */
@@ -261,6 +284,9 @@ failure:
   // Do this every frame or you'll see junk in the border.
   glClear(GL_COLOR_BUFFER_BIT);
 
+  if (zx)
+    pixels = zxspectrum_claim_screen(zx);
+
   if (pixels)
   {
     // Draw the image
@@ -322,7 +348,7 @@ failure:
   if ([chars length] == 0)
     return;
 
-  keys = zxkeyset_setchar(keys, [chars characterAtIndex:0]);
+  post_key(zx, event, zxkey_for_char([chars characterAtIndex:0]), true);
 
   // NSLog(@"Key pressed: %@", event);
 }
@@ -341,7 +367,7 @@ failure:
   if ([chars length] == 0)
     return;
 
-  keys = zxkeyset_clearchar(keys, [chars characterAtIndex:0]);
+  post_key(zx, event, zxkey_for_char([chars characterAtIndex:0]), false);
 
   // NSLog(@"Key released: %@", event);
 }
@@ -361,8 +387,8 @@ failure:
    * bool command = (modifierFlags & NSCommandKeyMask) != 0;
    */
 
-  zxkeyset_assign(&keys, zxkey_CAPS_SHIFT,   shift);
-  zxkeyset_assign(&keys, zxkey_SYMBOL_SHIFT, alt);
+  post_key(zx, event, zxkey_CAPS_SHIFT,   shift);
+  post_key(zx, event, zxkey_SYMBOL_SHIFT, alt);
 
   // NSLog(@"Key shift=%d control=%d alt=%d command=%d", shift, control, alt, command);
 }
@@ -41,8 +41,7 @@ typedef struct gamewin
   HANDLE        thread;
   DWORD         threadId;
 
-  zxkeyset_t    keys;
-  unsigned int *pixels;
+  const unsigned int *pixels;
 
   bool          quit;
 }
@@ -55,7 +54,8 @@ static void draw_handler(unsigned int *pixels, void *opaque)
   gamewin_t *gamewin = (gamewin_t *) opaque;
   RECT       rect;
 
-  gamewin->pixels = pixels;
+  // pixels is only valid during this call: WM_PAINT claims the latest frame
+  (void) pixels;
 
   rect.left   = 0;
   rect.top    = 0;
@@ -68,14 +68,30 @@ static void draw_handler(unsigned int *pixels, void *opaque)
 
 static void sleep_handler(int duration, sleeptype_t sleeptype, void *opaque)
 {
+  gamewin_t *gamewin = (gamewin_t *) opaque;
+
+  // Waits for input end as soon as a key is posted
+  if (sleeptype == sleeptype_KEYSCAN)
+  {
+    (void) zxspectrum_wait_for_event(gamewin->zx, duration);
+    return;
+  }
+
   Sleep(duration / 1000); // duration is taken literally for now
 }
 
-static int key_handler(uint16_t port, void *opaque)
+static void post_key(gamewin_t *gamewin, zxkey_t key, bool down)
 {
-  gamewin_t *gamewin = (gamewin_t *) opaque;
+  zxevent_t event;
 
-  return zxkeyset_for_port(port, gamewin->keys);
+  if (key == zxkey_UNKNOWN)
+    return;
+
+  event.timestamp = (uint32_t) GetMessageTime();
+  event.type      = zxeventtype_KEY;
+  event.index     = (uint8_t) key;
+  event.down      = down;
+  zxspectrum_post_event(gamewin->zx, &event);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -112,7 +128,9 @@ static int CreateGame(gamewin_t *gamewin)
   zxconfig.opaque = gamewin;
   zxconfig.draw   = draw_handler;
   zxconfig.sleep  = sleep_handler;
-  zxconfig.key    = key_handler;
+  zxconfig.key    = NULL; // keys are posted as events
+  zxconfig.frame_rate = 0; // unpaced: the game's own delays set its speed
+  zxconfig.layout = zxlayout_SPECTRUM;
 
   zx = zxspectrum_create(&zxconfig);
   if (zx == NULL)
@@ -150,7 +168,6 @@ static int CreateGame(gamewin_t *gamewin)
   gamewin->thread   = thread;
   gamewin->threadId = threadId;
 
-  gamewin->keys     = 0;
   gamewin->pixels   = NULL;
 
   gamewin->quit     = false;
@@ -218,6 +235,9 @@ LRESULT CALLBACK GameWindowProcedure(HWND   hwnd,
 
         hdc = BeginPaint(hwnd, &ps);
 
+        if (gamewin->zx)
+          gamewin->pixels = zxspectrum_claim_screen(gamewin->zx);
+
         GetClientRect(hwnd, &clientrect);
 
         StretchDIBits(hdc,
@@ -250,16 +270,11 @@ LRESULT CALLBACK GameWindowProcedure(HWND   hwnd,
         bool down = (message == WM_KEYDOWN);
 
         if (wParam == VK_CONTROL)
-          zxkeyset_assign(&gamewin->keys, zxkey_CAPS_SHIFT,   down);
+          post_key(gamewin, zxkey_CAPS_SHIFT, down);
         else if (wParam == VK_SHIFT)
-          zxkeyset_assign(&gamewin->keys, zxkey_SYMBOL_SHIFT, down);
+          post_key(gamewin, zxkey_SYMBOL_SHIFT, down);
         else
-        {
-          if (down)
-            gamewin->keys = zxkeyset_setchar(gamewin->keys, wParam);
-          else
-            gamewin->keys = zxkeyset_clearchar(gamewin->keys, wParam);
-        }
+          post_key(gamewin, zxkey_for_char((int) wParam), down);
       }
       break;
 